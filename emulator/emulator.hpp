@@ -26,9 +26,11 @@ namespace Emulator {
 #include <nall/endian.hpp>
 #include <nall/file.hpp>
 #include <nall/function.hpp>
+#include <nall/hashset.hpp>
 #include <nall/http.hpp>
 #include <nall/image.hpp>
 #include <nall/invoke.hpp>
+#include <nall/lz4.hpp>
 #include <nall/priority-queue.hpp>
 #include <nall/property.hpp>
 #include <nall/random.hpp>
@@ -77,6 +79,15 @@ template<typename R, typename... P> struct hook<R (P...)> {
   #define privileged private
 #endif
 
+//component singletons: one emulated system per process by default, or one per OS thread
+//with -DTHREAD_INSTANCES (each access then pays for thread-local storage);
+//read-only data stays process-wide: see Video::share_palette(), and ROMs mapped from their files
+#if defined(THREAD_INSTANCES)
+  #define threadlocal thread_local
+#else
+  #define threadlocal
+#endif
+
 typedef  int1_t  int1;
 typedef  int2_t  int2;
 typedef  int3_t  int3;
@@ -9,7 +9,7 @@ namespace GameBoy {
 #include "noise/noise.cpp"
 #include "master/master.cpp"
 #include "serialization.cpp"
-APU apu;
+threadlocal APU apu;
 
 void APU::Main() {
   apu.main();
@@ -26,4 +26,4 @@ struct APU : Thread, MMIO {
   void serialize(serializer&);
 };
 
-extern APU apu;
+extern threadlocal APU apu;
@@ -12,7 +12,7 @@ namespace GameBoy {
 #include "huc1/huc1.cpp"
 #include "huc3/huc3.cpp"
 #include "serialization.cpp"
-Cartridge cartridge;
+threadlocal Cartridge cartridge;
 
 string Cartridge::title() {
   return information.title;
@@ -73,4 +73,4 @@ struct Cartridge : MMIO, property<Cartridge> {
   ~Cartridge();
 };
 
-extern Cartridge cartridge;
+extern threadlocal Cartridge cartridge;
@@ -3,7 +3,7 @@
 
 namespace GameBoy {
 
-Cheat cheat;
+threadlocal Cheat cheat;
 
 void Cheat::reset() {
   codes.reset();
@@ -17,4 +17,4 @@ struct Cheat {
   void synchronize();
 };
 
-extern Cheat cheat;
+extern threadlocal Cheat cheat;
@@ -7,7 +7,7 @@ namespace GameBoy {
 #include "memory.cpp"
 #include "timing.cpp"
 #include "serialization.cpp"
-CPU cpu;
+threadlocal CPU cpu;
 
 void CPU::Main() {
   cpu.main();
@@ -123,4 +123,4 @@ struct CPU : Processor::LR35902, Thread, MMIO {
   void hblank();
 };
 
-extern CPU cpu;
+extern threadlocal CPU cpu;
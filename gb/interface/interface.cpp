@@ -2,7 +2,7 @@
 
 namespace GameBoy {
 
-Interface* interface = nullptr;
+threadlocal Interface* interface = nullptr;
 
 void Interface::lcdScanline() {
   if(hook) hook->lcdScanline();
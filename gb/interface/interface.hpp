@@ -66,7 +66,7 @@ private:
   vector<Device> device;
 };
 
-extern Interface* interface;
+extern threadlocal Interface* interface;
 
 #ifndef GB_HPP
 }
@@ -3,8 +3,8 @@
 #define MEMORY_CPP
 namespace GameBoy {
 
-Unmapped unmapped;
-Bus bus;
+threadlocal Unmapped unmapped;
+threadlocal Bus bus;
 
 uint8_t& Memory::operator[](unsigned addr) {
   return data[addr];
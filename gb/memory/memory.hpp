@@ -28,5 +28,5 @@ struct Bus {
   void power();
 };
 
-extern Unmapped unmapped;
-extern Bus bus;
+extern threadlocal Unmapped unmapped;
+extern threadlocal Bus bus;
@@ -13,7 +13,7 @@ namespace GameBoy {
 #include "dmg.cpp"
 #include "cgb.cpp"
 #include "serialization.cpp"
-PPU ppu;
+threadlocal PPU ppu;
 
 void PPU::Main() {
   ppu.main();
@@ -119,4 +119,4 @@ struct PPU : Thread, MMIO {
   PPU();
 };
 
-extern PPU ppu;
+extern threadlocal PPU ppu;
@@ -3,7 +3,7 @@
 #define SCHEDULER_CPP
 namespace GameBoy {
 
-Scheduler scheduler;
+threadlocal Scheduler scheduler;
 
 void Scheduler::enter() {
   host_thread = co_active();
@@ -4,7 +4,7 @@
 namespace GameBoy {
 
 #include "serialization.cpp"
-System system;
+threadlocal System system;
 
 void System::run() {
   scheduler.sync = Scheduler::SynchronizeMode::None;
@@ -46,4 +46,4 @@ struct System {
 
 #include <gb/interface/interface.hpp>
 
-extern System system;
+extern threadlocal System system;
@@ -3,7 +3,7 @@
 #define VIDEO_CPP
 namespace GameBoy {
 
-Video video;
+threadlocal Video video;
 
 void Video::generate_palette(Emulator::Interface::PaletteMode mode) {
   this->mode = mode;
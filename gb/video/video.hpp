@@ -13,4 +13,4 @@ private:
   uint32_t palette_cgb(unsigned color) const;
 };
 
-extern Video video;
+extern threadlocal Video video;
@@ -9,7 +9,8 @@
 #include <assert.h>
 #include <stdlib.h>
 
-#if defined(__GNUC__) && !defined(_WIN32) && !defined(__cplusplus)
+//the inline co_switch addresses co_active_handle directly, so it cannot be used when that is thread-local
+#if defined(__GNUC__) && !defined(_WIN32) && !defined(__cplusplus) && !defined(LIBCO_MP) && !defined(THREAD_INSTANCES)
 #define CO_USE_INLINE_ASM
 #endif
 
@@ -26,7 +26,7 @@
 #include <retro_common_api.h>
 
 #ifdef LIBCO_C
-  #ifdef LIBCO_MP
+  #if defined(LIBCO_MP) || defined(THREAD_INSTANCES)
     #define thread_local __thread
   #else
     #define thread_local
@@ -55,11 +55,31 @@ inline uint32_t crc32_adjust(uint32_t crc32, uint8_t input) {
   return ((crc32 >> 8) & 0x00ffffff) ^ crc32_table[(crc32 ^ input) & 0xff];
 }
 
+//slicing-by-8: slice[n][byte] advances the CRC of byte over n more zero bytes,
+//so eight input bytes take eight independent table lookups instead of a dependent chain
 inline uint32_t crc32_calculate(const uint8_t* data, unsigned length) {
+  struct Slices {
+    uint32_t slice[8][256];
+    Slices() {
+      for(unsigned n = 0; n < 256; n++) slice[0][n] = crc32_table[n];
+      for(unsigned k = 1; k < 8; k++) {
+        for(unsigned n = 0; n < 256; n++) slice[k][n] = crc32_adjust(slice[k - 1][n], 0);
+      }
+    }
+  };
+  static const Slices tables;
+  auto& slice = tables.slice;
+
   uint32_t crc32 = ~0;
-  for(unsigned i = 0; i < length; i++) {
-    crc32 = crc32_adjust(crc32, data[i]);
+  while(length >= 8) {
+    uint32_t lo = crc32 ^ (data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24);
+    uint32_t hi = data[4] | data[5] << 8 | data[6] << 16 | (uint32_t)data[7] << 24;
+    crc32 = slice[7][lo & 0xff] ^ slice[6][lo >> 8 & 0xff] ^ slice[5][lo >> 16 & 0xff] ^ slice[4][lo >> 24]
+          ^ slice[3][hi & 0xff] ^ slice[2][hi >> 8 & 0xff] ^ slice[1][hi >> 16 & 0xff] ^ slice[0][hi >> 24];
+    data += 8;
+    length -= 8;
   }
+  while(length--) crc32 = crc32_adjust(crc32, *data++);
   return ~crc32;
 }
 
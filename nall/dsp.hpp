@@ -6,6 +6,8 @@
 #include <algorithm>
 #ifdef __SSE__
   #include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
 #endif
 
 #define NALL_DSP_INTERNAL_HPP
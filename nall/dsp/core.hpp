@@ -18,6 +18,7 @@ struct Resampler {
   virtual void setFrequency() = 0;
   virtual void clear() = 0;
   virtual void sample() = 0;
+  inline virtual void sample(const real* input, unsigned frames);
   Resampler(DSP& dsp) : dsp(dsp) {}
   virtual ~Resampler() {}
 };
@@ -31,6 +32,7 @@ struct DSP {
     Hermite,
     Average,
     Sinc,
+    Polyphase,
   };
 
   inline void setChannels(unsigned channels);
@@ -43,6 +45,7 @@ struct DSP {
   inline void setResamplerFrequency(real frequency);  //outputFrequency
 
   inline void sample(signed channel[]);
+  inline void sample(const signed* samples, unsigned frames);  //interleaved
   inline bool pending();
   inline void read(signed channel[]);
 
@@ -58,6 +61,8 @@ protected:
   friend class ResampleAverage;
   friend class ResampleHermite;
   friend class ResampleSinc;
+  friend class ResamplePolyphase;
+  friend class Resampler;
 
   struct Settings {
     unsigned channels;
@@ -90,6 +95,7 @@ protected:
 #include "resample/hermite.hpp"
 #include "resample/average.hpp"
 #include "resample/sinc.hpp"
+#include "resample/polyphase.hpp"
 #include "settings.hpp"
 
 void DSP::sample(signed channel[]) {
@@ -100,6 +106,33 @@ void DSP::sample(signed channel[]) {
   resampler->sample();
 }
 
+//engines without a block path resample one frame at a time
+void Resampler::sample(const real* input, unsigned frames) {
+  for(unsigned n = 0; n < frames; n++) {
+    for(unsigned c = 0; c < dsp.settings.channels; c++) {
+      dsp.buffer.write(c) = *input++;
+    }
+    dsp.buffer.wroffset++;
+    sample();
+  }
+}
+
+void DSP::sample(const signed* samples, unsigned frames) {
+  enum : unsigned { BlockSamples = 2048 };
+  real block[BlockSamples];
+  unsigned blockFrames = BlockSamples / settings.channels;
+
+  while(frames) {
+    unsigned length = std::min(frames, blockFrames);
+    for(unsigned n = 0; n < length * settings.channels; n++) {
+      block[n] = (real)samples[n] * settings.intensityInverse;
+    }
+    resampler->sample(block, length);
+    samples += length * settings.channels;
+    frames -= length;
+  }
+}
+
 bool DSP::pending() {
   return output.rdoffset != output.wroffset;
 }
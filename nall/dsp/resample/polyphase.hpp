@@ -0,0 +1,260 @@
+#ifdef NALL_DSP_INTERNAL_HPP
+
+//block-oriented counterpart of ResampleSinc, using the same filter design:
+//an optional integer decimation stage (for large ratios) followed by a polyphase FIR.
+//all channels share one set of coefficient tables and are filtered over whole blocks of input,
+//rather than once per sample through a private resampler per channel.
+struct ResamplePolyphase : Resampler {
+  inline void setFrequency();
+  inline void clear();
+  inline void sample();
+  inline void sample(const real* input, unsigned frames);
+  inline ResamplePolyphase(DSP& dsp);
+
+private:
+  inline void process();
+  inline static float dot(const float* wave, const float* coeff, unsigned count);
+  inline static void dot(const float* wave, const float* coeffA, const float* coeffB, unsigned count, float& resultA, float& resultB);
+  inline static void append(std::vector<float>& buffer, unsigned length, unsigned count);
+  inline static void consume(std::vector<float>& buffer, unsigned length, unsigned count);
+
+  //padding so that kernels may read up to seven samples past the valid range (against zero coefficients)
+  enum : unsigned { Padding = 8 };
+  enum : unsigned { Channels = 8 };  //most channels supported
+
+  //stage 1: decimate by an integer factor
+  unsigned decimation;  //0 = stage unused
+  unsigned decimationConvolutions;
+  unsigned decimationTaps;  //decimationConvolutions rounded up to a multiple of 8
+  std::vector<float> decimationCoeffs;
+
+  //stage 2: polyphase FIR; (phases + 2) rows of taps, interpolated between adjacent phases
+  unsigned convolutions;
+  unsigned taps;
+  unsigned phases;
+  std::vector<float> coeffs;
+  unsigned stepInt;
+  double stepFract;
+  double fraction;
+
+  std::vector<float> input[Channels];  //stage 1 history per channel
+  std::vector<float> history[Channels];  //stage 2 history per channel
+  unsigned inputLength;
+  unsigned historyLength;
+};
+
+ResamplePolyphase::ResamplePolyphase(DSP& dsp) : Resampler(dsp) {
+  decimation = 0;
+  convolutions = 0;
+  inputLength = historyLength = 0;
+}
+
+void ResamplePolyphase::setFrequency() {
+  //parameters of SincResample::QUALITY_HIGH with the 0.85 bandwidth used by ResampleSinc
+  const double bandwidth = 0.85, beta = 10.056, d = 6.4;
+  const unsigned pnNume = 65536, phasesMin = 32;
+
+  double inputRate = dsp.settings.frequency;
+  double outputRate = frequency;
+  if(inputRate <= 0 || outputRate <= 0) return;
+  assert(dsp.settings.channels <= Channels);
+
+  decimation = (unsigned)floor(inputRate / (outputRate * (1.0 + (1.0 - bandwidth) / 2))) & ~3;
+  if(decimation >= 8) {
+    decimationConvolutions = (unsigned)ceil(d / ((1.0 - bandwidth) / decimation)) | 1;
+    double cutoff = (1.0 / decimation) - (d / decimationConvolutions);
+    std::vector<double> buffer(decimationConvolutions);
+    ResampleUtility::gen_sinc_os(&buffer[0], decimationConvolutions, cutoff, beta);
+    ResampleUtility::normalize(&buffer[0], decimationConvolutions);
+
+    decimationTaps = (decimationConvolutions + 7) & ~7;
+    decimationCoeffs.assign(decimationTaps, 0.0f);
+    for(unsigned n = 0; n < decimationConvolutions; n++) decimationCoeffs[n] = buffer[n];
+    inputRate /= decimation;
+  } else {
+    decimation = 0;
+  }
+
+  double ratio = outputRate / inputRate;
+  if(outputRate > inputRate) {
+    convolutions = ((unsigned)ceil(d / (1.0 - bandwidth)) + 1) & ~1;
+  } else {
+    convolutions = ((unsigned)ceil(d / (ratio * (1.0 - bandwidth))) + 1) & ~1;
+  }
+  double cutoff = (outputRate > inputRate ? bandwidth : ratio * bandwidth);
+  phases = (std::max<unsigned>(pnNume / convolutions, phasesMin) + 1) & ~1;
+  cutoff /= phases;
+
+  std::vector<double> buffer(phases * convolutions);
+  ResampleUtility::gen_sinc(&buffer[0], phases * convolutions, cutoff, beta);
+  ResampleUtility::normalize(&buffer[0], phases * convolutions, phases);
+
+  //row (phase + 1) holds every phase'th coefficient, so each output is a contiguous dot product
+  taps = (convolutions + 7) & ~7;
+  coeffs.assign((phases + 2) * taps, 0.0f);
+  for(signed phase = -1; phase < (signed)phases + 1; phase++) {
+    for(signed conv = 0; conv < (signed)convolutions; conv++) {
+      if(phase == -1 && conv == 0) continue;
+      if(phase == (signed)phases && conv == (signed)convolutions - 1) continue;
+      coeffs[(phase + 1) * taps + conv] = buffer[conv * phases + phase];
+    }
+  }
+
+  double step = inputRate / outputRate;
+  stepInt = floor(step);
+  stepFract = step - stepInt;
+
+  clear();
+}
+
+void ResamplePolyphase::clear() {
+  fraction = 0.0;
+  inputLength = historyLength = 0;
+  for(unsigned c = 0; c < Channels; c++) {
+    input[c].clear();
+    history[c].clear();
+  }
+}
+
+void ResamplePolyphase::sample() {
+  real channel[Channels];
+  for(unsigned c = 0; c < dsp.settings.channels; c++) {
+    channel[c] = dsp.buffer.read(c);
+  }
+  sample(channel, 1);
+  dsp.buffer.rdoffset++;
+}
+
+void ResamplePolyphase::sample(const real* samples, unsigned frames) {
+  if(convolutions == 0) return;
+  unsigned channels = dsp.settings.channels;
+
+  if(decimation) {
+    for(unsigned c = 0; c < channels; c++) {
+      append(input[c], inputLength, frames);
+      for(unsigned n = 0; n < frames; n++) input[c][inputLength + n] = samples[n * channels + c];
+    }
+    inputLength += frames;
+  } else {
+    for(unsigned c = 0; c < channels; c++) {
+      append(history[c], historyLength, frames);
+      for(unsigned n = 0; n < frames; n++) history[c][historyLength + n] = samples[n * channels + c];
+    }
+    historyLength += frames;
+  }
+
+  process();
+}
+
+void ResamplePolyphase::process() {
+  unsigned channels = dsp.settings.channels;
+
+  if(decimation) {
+    unsigned offset = 0;
+    unsigned count = inputLength >= decimationConvolutions ? (inputLength - decimationConvolutions) / decimation + 1 : 0;
+    for(unsigned c = 0; c < channels; c++) append(history[c], historyLength, count);
+    for(unsigned n = 0; n < count; n++, offset += decimation) {
+      for(unsigned c = 0; c < channels; c++) {
+        history[c][historyLength + n] = dot(&input[c][offset], &decimationCoeffs[0], decimationTaps);
+      }
+    }
+    historyLength += count;
+    for(unsigned c = 0; c < channels; c++) consume(input[c], inputLength, offset);
+    inputLength -= offset;
+  }
+
+  unsigned offset = 0;
+  while(offset <= historyLength && historyLength - offset >= convolutions) {
+    double phase = fraction * phases - 0.5;
+    signed phaseInt = (signed)floor(phase);
+    float phaseFract = phase - phaseInt;
+    const float* coeffA = &coeffs[(phases - phaseInt) * taps];
+    const float* coeffB = coeffA - taps;
+
+    real channel[Channels];
+    for(unsigned c = 0; c < channels; c++) {
+      float a, b;
+      dot(&history[c][offset], coeffA, coeffB, taps, a, b);
+      channel[c] = a * (1.0f - phaseFract) + b * phaseFract;
+    }
+    dsp.write(channel);
+
+    fraction += stepFract;
+    offset += stepInt + (unsigned)floor(fraction);
+    fraction -= floor(fraction);
+  }
+  if(offset > historyLength) offset = historyLength;
+  for(unsigned c = 0; c < channels; c++) consume(history[c], historyLength, offset);
+  historyLength -= offset;
+}
+
+float ResamplePolyphase::dot(const float* wave, const float* coeff, unsigned count) {
+#if defined(__SSE__)
+  __m128 accumA = _mm_setzero_ps(), accumB = _mm_setzero_ps();
+  for(unsigned n = 0; n < count; n += 8) {
+    accumA = _mm_add_ps(accumA, _mm_mul_ps(_mm_loadu_ps(wave + n + 0), _mm_loadu_ps(coeff + n + 0)));
+    accumB = _mm_add_ps(accumB, _mm_mul_ps(_mm_loadu_ps(wave + n + 4), _mm_loadu_ps(coeff + n + 4)));
+  }
+  float sum[4];
+  _mm_storeu_ps(sum, _mm_add_ps(accumA, accumB));
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#elif defined(__ARM_NEON)
+  float32x4_t accumA = vdupq_n_f32(0), accumB = vdupq_n_f32(0);
+  for(unsigned n = 0; n < count; n += 8) {
+    accumA = vmlaq_f32(accumA, vld1q_f32(wave + n + 0), vld1q_f32(coeff + n + 0));
+    accumB = vmlaq_f32(accumB, vld1q_f32(wave + n + 4), vld1q_f32(coeff + n + 4));
+  }
+  float32x4_t accum = vaddq_f32(accumA, accumB);
+  return (vgetq_lane_f32(accum, 0) + vgetq_lane_f32(accum, 1)) + (vgetq_lane_f32(accum, 2) + vgetq_lane_f32(accum, 3));
+#else
+  float accum[4] = {0, 0, 0, 0};
+  for(unsigned n = 0; n < count; n += 4) {
+    accum[0] += wave[n + 0] * coeff[n + 0];
+    accum[1] += wave[n + 1] * coeff[n + 1];
+    accum[2] += wave[n + 2] * coeff[n + 2];
+    accum[3] += wave[n + 3] * coeff[n + 3];
+  }
+  return (accum[0] + accum[1]) + (accum[2] + accum[3]);
+#endif
+}
+
+void ResamplePolyphase::dot(const float* wave, const float* coeffA, const float* coeffB, unsigned count, float& resultA, float& resultB) {
+#if defined(__SSE__)
+  __m128 accumA = _mm_setzero_ps(), accumB = _mm_setzero_ps();
+  for(unsigned n = 0; n < count; n += 4) {
+    __m128 w = _mm_loadu_ps(wave + n);
+    accumA = _mm_add_ps(accumA, _mm_mul_ps(w, _mm_loadu_ps(coeffA + n)));
+    accumB = _mm_add_ps(accumB, _mm_mul_ps(w, _mm_loadu_ps(coeffB + n)));
+  }
+  float sumA[4], sumB[4];
+  _mm_storeu_ps(sumA, accumA);
+  _mm_storeu_ps(sumB, accumB);
+  resultA = (sumA[0] + sumA[1]) + (sumA[2] + sumA[3]);
+  resultB = (sumB[0] + sumB[1]) + (sumB[2] + sumB[3]);
+#elif defined(__ARM_NEON)
+  float32x4_t accumA = vdupq_n_f32(0), accumB = vdupq_n_f32(0);
+  for(unsigned n = 0; n < count; n += 4) {
+    float32x4_t w = vld1q_f32(wave + n);
+    accumA = vmlaq_f32(accumA, w, vld1q_f32(coeffA + n));
+    accumB = vmlaq_f32(accumB, w, vld1q_f32(coeffB + n));
+  }
+  resultA = (vgetq_lane_f32(accumA, 0) + vgetq_lane_f32(accumA, 1)) + (vgetq_lane_f32(accumA, 2) + vgetq_lane_f32(accumA, 3));
+  resultB = (vgetq_lane_f32(accumB, 0) + vgetq_lane_f32(accumB, 1)) + (vgetq_lane_f32(accumB, 2) + vgetq_lane_f32(accumB, 3));
+#else
+  resultA = dot(wave, coeffA, count);
+  resultB = dot(wave, coeffB, count);
+#endif
+}
+
+//make room for count more samples past length, keeping the padding zero-initialized on growth
+void ResamplePolyphase::append(std::vector<float>& buffer, unsigned length, unsigned count) {
+  if(buffer.size() < length + count + Padding) buffer.resize((length + count + Padding) * 2, 0.0f);
+}
+
+//drop the first count samples that no further output depends upon
+void ResamplePolyphase::consume(std::vector<float>& buffer, unsigned length, unsigned count) {
+  if(count == 0) return;
+  memmove(&buffer[0], &buffer[count], (length - count) * sizeof(float));
+}
+
+#endif
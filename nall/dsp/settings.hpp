@@ -37,6 +37,7 @@ void DSP::setResampler(ResampleEngine engine) {
   case ResampleEngine::Hermite: resampler = new ResampleHermite(*this); return;
   case ResampleEngine::Average: resampler = new ResampleAverage(*this); return;
   case ResampleEngine::Sinc:    resampler = new ResampleSinc   (*this); return;
+  case ResampleEngine::Polyphase: resampler = new ResamplePolyphase(*this); return;
   }
 
   throw;
@@ -0,0 +1,121 @@
+#ifndef NALL_LZ4_HPP
+#define NALL_LZ4_HPP
+
+//LZ4 block format (no frame header): fast enough to compress every save state,
+//and the output can be decoded by any LZ4 implementation given the uncompressed size.
+
+#include <string.h>
+#include <nall/stdint.hpp>
+
+namespace nall {
+
+//largest possible output of lz4_compress() for size bytes of input
+inline unsigned lz4_bound(unsigned size) {
+  return size + size / 255 + 16;
+}
+
+//returns the number of bytes written to target, which must hold lz4_bound(sourceLength) bytes
+inline unsigned lz4_compress(uint8_t* target, const uint8_t* source, unsigned sourceLength) {
+  enum : unsigned { HashBits = 12, MinMatch = 4, LastLiterals = 5, MatchLimit = 12 };
+  uint32_t table[1 << HashBits] = {0};
+  uint8_t* output = target;
+
+  auto read32 = [&](unsigned offset) -> uint32_t {
+    uint32_t data;
+    memcpy(&data, source + offset, 4);
+    return data;
+  };
+
+  auto length = [&](unsigned data) {
+    while(data >= 255) *output++ = 255, data -= 255;
+    *output++ = data;
+  };
+
+  auto sequence = [&](unsigned anchor, unsigned literals, unsigned distance, unsigned match) {
+    uint8_t* token = output++;
+    *token = (literals < 15 ? literals : 15) << 4;
+    if(literals >= 15) length(literals - 15);
+    memcpy(output, source + anchor, literals);
+    output += literals;
+    if(distance == 0) return;  //the final sequence is literals only
+    *token |= match < 15 ? match : 15;
+    *output++ = distance;
+    *output++ = distance >> 8;
+    if(match >= 15) length(match - 15);
+  };
+
+  unsigned anchor = 0, offset = 0;
+  if(sourceLength > MatchLimit) {
+    unsigned limit = sourceLength - MatchLimit;
+    unsigned last = sourceLength - LastLiterals;  //matches may not cover the final bytes
+    while(offset < limit) {
+      uint32_t data = read32(offset);
+      uint32_t& entry = table[(data * 2654435761u) >> (32 - HashBits)];
+      unsigned reference = entry;
+      entry = offset;
+      if(reference >= offset || offset - reference > 65535 || read32(reference) != data) {
+        offset += 1 + ((offset - anchor) >> 6);  //skip faster through data that does not compress
+        continue;
+      }
+
+      unsigned end = offset + MinMatch, from = reference + MinMatch;
+      while(end + 8 <= last && !memcmp(source + end, source + from, 8)) end += 8, from += 8;
+      while(end < last && source[end] == source[from]) end++, from++;
+
+      sequence(anchor, offset - anchor, offset - reference, end - offset - MinMatch);
+      anchor = offset = end;
+    }
+  }
+
+  sequence(anchor, sourceLength - anchor, 0, 0);
+  return output - target;
+}
+
+//fails unless source decodes to exactly targetLength bytes
+inline bool lz4_decompress(uint8_t* target, unsigned targetLength, const uint8_t* source, unsigned sourceLength) {
+  const uint8_t* end = source + sourceLength;
+  unsigned offset = 0;
+
+  auto length = [&](unsigned& data) -> bool {
+    uint8_t byte;
+    do {
+      if(source == end) return false;
+      data += byte = *source++;
+    } while(byte == 255);
+    return true;
+  };
+
+  while(source < end) {
+    unsigned token = *source++;
+    unsigned literals = token >> 4;
+    if(literals == 15 && !length(literals)) return false;
+    if(literals > end - source || literals > targetLength - offset) return false;
+    memcpy(target + offset, source, literals);
+    source += literals;
+    offset += literals;
+    if(source == end) break;  //the final sequence is literals only
+
+    if(end - source < 2) return false;
+    unsigned distance = source[0] | source[1] << 8;
+    source += 2;
+    unsigned match = token & 15;
+    if(match == 15 && !length(match)) return false;
+    match += 4;
+    if(distance == 0 || distance > offset || match > targetLength - offset) return false;
+
+    //an overlapping match repeats its first distance bytes: copy them in blocks that double in size
+    unsigned from = offset - distance;
+    while(match) {
+      unsigned size = offset - from < match ? offset - from : match;
+      memcpy(target + offset, target + from, size);
+      offset += size;
+      match -= size;
+    }
+  }
+
+  return offset == targetLength;
+}
+
+}
+
+#endif
@@ -12,8 +12,10 @@
 //- only plain-old-data can be stored. complex classes must provide serialize(serializer&);
 //- floating-point usage is not portable across different implementations
 
+#include <string.h>
 #include <type_traits>
 #include <utility>
+#include <nall/intrinsics.hpp>
 #include <nall/stdint.hpp>
 #include <nall/utility.hpp>
 
@@ -76,13 +78,11 @@ struct serializer {
   }
 
   template<typename T, int N> serializer& array(T (&array)[N]) {
-    for(unsigned n = 0; n < N; n++) operator()(array[n]);
-    return *this;
+    return elements(array, N);
   }
 
   template<typename T> serializer& array(T array, unsigned size) {
-    for(unsigned n = 0; n < size; n++) operator()(array[n]);
-    return *this;
+    return elements(array, size);
   }
 
   template<typename T> serializer& operator()(T& value, typename std::enable_if<has_serialize<T>::value>::type* = 0) { value.serialize(*this); return *this; }
@@ -92,24 +92,26 @@ struct serializer {
   template<typename T> serializer& operator()(T& value, unsigned size, typename std::enable_if<std::is_pointer<T>::value>::type* = 0) { return array(value, size); }
 
   serializer& operator=(const serializer& s) {
-    if(_data) delete[] _data;
+    if(_data && _owner) delete[] _data;
 
     _mode = s._mode;
     _data = new uint8_t[s._capacity];
     _size = s._size;
     _capacity = s._capacity;
+    _owner = true;
 
     memcpy(_data, s._data, s._capacity);
     return *this;
   }
 
   serializer& operator=(serializer&& s) {
-    if(_data) delete[] _data;
+    if(_data && _owner) delete[] _data;
 
     _mode = s._mode;
     _data = s._data;
     _size = s._size;
     _capacity = s._capacity;
+    _owner = s._owner;
 
     s._data = nullptr;
     return *this;
@@ -134,15 +136,52 @@ struct serializer {
     memcpy(_data, data, capacity);
   }
 
+  //loads straight from the caller's buffer instead of a copy; the buffer must outlive the view
+  static serializer view(const uint8_t* data, unsigned capacity) {
+    serializer s;
+    s._mode = Load;
+    s._data = (uint8_t*)data;
+    s._capacity = capacity;
+    s._owner = false;
+    return s;
+  }
+
   ~serializer() {
-    if(_data) delete[] _data;
+    if(_data && _owner) delete[] _data;
   }
 
 private:
+  //integers are stored little-endian, so on little-endian hosts an array of them
+  //is already in serialized form and moves as one block (bool is excluded: not every byte is a valid bool)
+  template<typename T> static constexpr bool is_block() {
+    #if defined(ENDIAN_LSB)
+    return std::is_integral<T>::value && !std::is_same<bool, T>::value;
+    #else
+    return std::is_integral<T>::value && !std::is_same<bool, T>::value && sizeof(T) == 1;
+    #endif
+  }
+
+  template<typename T> typename std::enable_if<is_block<T>(), serializer&>::type elements(T* array, unsigned count) {
+    unsigned size = count * sizeof(T);
+    if(_mode == Save) {
+      memcpy(_data + _size, array, size);
+    } else if(_mode == Load) {
+      memcpy(array, _data + _size, size);
+    }
+    _size += size;
+    return *this;
+  }
+
+  template<typename T> typename std::enable_if<!is_block<T>(), serializer&>::type elements(T* array, unsigned count) {
+    for(unsigned n = 0; n < count; n++) operator()(array[n]);
+    return *this;
+  }
+
   mode_t _mode = Size;
   uint8_t* _data = nullptr;
   unsigned _size = 0;
   unsigned _capacity = 0;
+  bool _owner = true;  //false for a view of someone else's buffer
 };
 
 };
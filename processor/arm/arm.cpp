@@ -23,6 +23,14 @@ void ARM::power() {
   instructions = 0;
 }
 
+void ARM::arm_cache(uint32 select, uint32 mask) {
+  cache.enabled = true;
+  cache.select = select;
+  cache.mask = mask;
+  cache.decoded.reset();
+  cache.decoded.resize((mask >> 2) + 1);
+}
+
 void ARM::exec() {
   cpsr().t ? thumb_step() : arm_step();
 }
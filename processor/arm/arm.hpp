@@ -37,6 +37,17 @@ struct ARM {
   uint32 ror(uint32 source, uint8 shift);
   uint32 rrx(uint32 source);
 
+  //arm_step() caches decoded instructions of memory that never changes (eg program ROM):
+  //addresses with no bits of select set share a slot per word of (address & mask).
+  //off until arm_cache() is called
+  struct Cache {
+    bool enabled = false;
+    uint32 select = 0;
+    uint32 mask = 0;
+    nall::vector<uint8> decoded;  //0 = not yet decoded, else one more than the ArmOp index
+  } cache;
+  void arm_cache(uint32 select, uint32 mask);
+
   void serialize(serializer&);
 
   bool trace;
@@ -28,10 +28,21 @@ void ARM::arm_step() {
 
   if(condition(instruction() >> 28) == false) return;
 
+  if(cache.enabled && (pipeline.execute.address & cache.select) == 0) {
+    uint8& op = cache.decoded.data()[(pipeline.execute.address & cache.mask) >> 2];
+    if(op == 0) op = 1 + arm_decode(instruction());
+    return (this->*arm_ops[op - 1])();
+  }
+
+  (this->*arm_ops[arm_decode(instruction())])();
+}
+
+//returns the index into arm_ops[] of the instruction's handler
+uint8 ARM::arm_decode(uint32 instruction) {
   #define decode(pattern, execute) if( \
-    (instruction() & std::integral_constant<uint32, bit::mask(pattern)>::value) \
+    (instruction & std::integral_constant<uint32, bit::mask(pattern)>::value) \
     == std::integral_constant<uint32, bit::test(pattern)>::value \
-  ) return arm_op_ ## execute()
+  ) return ArmOp::execute
 
   decode("???? 0001 0010 ++++ ++++ ++++ 0001 ????", branch_exchange_register);
   decode("???? 0000 00?? ???? ???? ???? 1001 ????", multiply);
@@ -55,6 +66,33 @@ void ARM::arm_step() {
 
   #undef decode
 
+  return ArmOp::undefined;
+}
+
+void (ARM::*const ARM::arm_ops[])() = {
+  &ARM::arm_op_branch_exchange_register,
+  &ARM::arm_op_multiply,
+  &ARM::arm_op_multiply_long,
+  &ARM::arm_op_move_to_register_from_status,
+  &ARM::arm_op_memory_swap,
+  &ARM::arm_op_move_to_status_from_register,
+  &ARM::arm_op_move_to_status_from_immediate,
+  &ARM::arm_op_load_register,
+  &ARM::arm_op_load_immediate,
+  &ARM::arm_op_move_half_register,
+  &ARM::arm_op_move_half_immediate,
+  &ARM::arm_op_data_immediate_shift,
+  &ARM::arm_op_data_register_shift,
+  &ARM::arm_op_data_immediate,
+  &ARM::arm_op_move_immediate_offset,
+  &ARM::arm_op_move_register_offset,
+  &ARM::arm_op_move_multiple,
+  &ARM::arm_op_branch,
+  &ARM::arm_op_software_interrupt,
+  &ARM::arm_op_undefined,
+};
+
+void ARM::arm_op_undefined() {
   crash = true;
 }
 
@@ -1,4 +1,33 @@
 void arm_step();
+uint8 arm_decode(uint32 instruction);
+
+//handler indices, in arm_decode() order
+struct ArmOp {
+  enum : uint8 {
+    branch_exchange_register,
+    multiply,
+    multiply_long,
+    move_to_register_from_status,
+    memory_swap,
+    move_to_status_from_register,
+    move_to_status_from_immediate,
+    load_register,
+    load_immediate,
+    move_half_register,
+    move_half_immediate,
+    data_immediate_shift,
+    data_register_shift,
+    data_immediate,
+    move_immediate_offset,
+    move_register_offset,
+    move_multiple,
+    branch,
+    software_interrupt,
+    undefined,
+  };
+};
+
+static void (ARM::*const arm_ops[])();
 
 void arm_opcode(uint32 rm);
 void arm_move_to_status(uint32 rm);
@@ -24,3 +53,4 @@ void arm_op_move_register_offset();
 void arm_op_move_multiple();
 void arm_op_branch();
 void arm_op_software_interrupt();
+void arm_op_undefined();
@@ -148,4 +148,4 @@ private:
   } status;
 };
 
-extern CPU cpu;
+extern threadlocal CPU cpu;
@@ -234,6 +234,10 @@ private:
 
 public:
 	bool mute() { return m.regs[r_flg] & 0x40; }
+	
+	// True if the echo buffer may write to addr before the next register
+	// write, under either the latched or the pending ESA/EDL/FLG settings
+	bool echo_may_write( int addr ) const;
 };
 
 #include <assert.h>
@@ -283,6 +287,21 @@ inline bool SPC_DSP::check_kon()
 	return old;
 }
 
+inline bool SPC_DSP::echo_may_write( int addr ) const
+{
+	if ( m.t_echo_enabled & m.regs [r_flg] & 0x20 )
+		return false;
+	
+	int length = (m.regs [r_edl] & 0x0F) * 0x800;
+	if ( length < m.echo_length )
+		length = m.echo_length;
+	length += 4;
+	
+	return ((addr - m.t_echo_ptr) & 0xFFFF) < 4 ||
+			((addr - m.t_esa * 0x100) & 0xFFFF) < length ||
+			((addr - m.regs [r_esa] * 0x100) & 0xFFFF) < length;
+}
+
 #if !SPC_NO_COPY_STATE_FUNCS
 
 class SPC_State_Copier {
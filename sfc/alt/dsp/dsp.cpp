@@ -3,7 +3,7 @@
 #define DSP_CPP
 namespace SuperFamicom {
 
-DSP dsp;
+threadlocal DSP dsp;
 
 #include "serialization.cpp"
 #include "SPC_DSP.cpp"
@@ -20,14 +20,21 @@ void DSP::synchronize_smp() {
   }
 }
 
+//runs every clock owed to the S-SMP in one pass;
+//chunked so that the output never exceeds samplebuffer
 void DSP::enter() {
-  spc_dsp.run(1);
-  step(24);
+  signed clocks = clock < 0 ? (-clock + 23) / 24 : 1;
+  while(clocks > 0) {
+    signed length = min(clocks, 4096);
+    spc_dsp.run(length);
+    step(length * 24);
+    clocks -= length;
 
-  signed count = spc_dsp.sample_count();
-  if(count > 0) {
-    for(unsigned n = 0; n < count; n += 2) audio.sample(samplebuffer[n + 0], samplebuffer[n + 1]);
-    spc_dsp.set_output(samplebuffer, 8192);
+    signed count = spc_dsp.sample_count();
+    if(count > 0) {
+      for(unsigned n = 0; n < count; n += 2) audio.sample(samplebuffer[n + 0], samplebuffer[n + 1]);
+      spc_dsp.set_output(samplebuffer, 8192);
+    }
   }
 }
 
@@ -14,6 +14,7 @@ struct DSP : Thread {
   void reset();
 
   void channel_enable(unsigned channel, bool enable);
+  bool echo_may_write(uint16 addr) const { return spc_dsp.echo_may_write(addr); }
 
   void serialize(serializer&);
   DSP();
@@ -24,4 +25,4 @@ private:
   bool channel_enabled[8];
 };
 
-extern DSP dsp;
+extern threadlocal DSP dsp;
@@ -3,7 +3,7 @@
 #define PPU_CPP
 namespace SuperFamicom {
 
-PPU ppu;
+threadlocal PPU ppu;
 
 #include "memory/memory.cpp"
 #include "mmio/mmio.cpp"
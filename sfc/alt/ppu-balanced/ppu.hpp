@@ -73,4 +73,4 @@ struct PPU : Thread, public PPUcounter {
   ~PPU();
 };
 
-extern PPU ppu;
+extern threadlocal PPU ppu;
@@ -3,7 +3,7 @@
 #define PPU_CPP
 namespace SuperFamicom {
 
-PPU ppu;
+threadlocal PPU ppu;
 
 #include "mmio/mmio.cpp"
 #include "window/window.cpp"
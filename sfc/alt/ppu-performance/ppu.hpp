@@ -65,4 +65,4 @@ private:
   friend class Video;
 };
 
-extern PPU ppu;
+extern threadlocal PPU ppu;
@@ -5,7 +5,6 @@ void SMP::tick() {
 
   clock += cycle_step_cpu;
   dsp.clock -= 24;
-  synchronize_dsp();
 }
 
 void SMP::op_io() {
@@ -20,6 +19,7 @@ uint8 SMP::op_read(uint16 addr) {
   #endif
   if((addr & 0xfff0) == 0x00f0) return mmio_read(addr);
   if(addr >= 0xffc0 && status.iplrom_enable) return iplrom[addr & 0x3f];
+  if(dsp.echo_may_write(addr)) synchronize_dsp();
   return apuram[addr];
 }
 
@@ -27,6 +27,7 @@ void SMP::op_write(uint16 addr, uint8 data) {
   #if defined(CYCLE_ACCURATE)
   tick();
   #endif
+  synchronize_dsp();  //the S-DSP may read any address, as BRR data or echo buffer
   if((addr & 0xfff0) == 0x00f0) mmio_write(addr, data);
   apuram[addr] = data;  //all writes go to RAM, even MMIO writes
 }
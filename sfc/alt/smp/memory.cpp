@@ -13,6 +13,7 @@ unsigned SMP::mmio_read(unsigned addr) {
     return status.dsp_addr;
 
   case 0xf3:
+    synchronize_dsp();
     return dsp.read(status.dsp_addr & 0x7f);
 
   case 0xf4:
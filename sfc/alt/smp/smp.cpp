@@ -5,7 +5,7 @@
 #define SMP_CPP
 namespace SuperFamicom {
 
-SMP smp;
+threadlocal SMP smp;
 
 #include "algorithms.cpp"
 #include "core.cpp"
@@ -28,8 +28,11 @@ void SMP::synchronize_dsp() {
   }
 }
 
+//the S-DSP is run lazily: it is caught up whenever the S-SMP could observe or affect it,
+//and once the S-SMP has caught up with the S-CPU
 void SMP::enter() {
   while(clock < 0) op_step();
+  synchronize_dsp();
 }
 
 void SMP::power() {
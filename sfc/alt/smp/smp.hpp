@@ -113,4 +113,4 @@ struct SMP : Thread {
   uint8  op_ror (uint8  x);
 };
 
-extern SMP smp;
+extern threadlocal SMP smp;
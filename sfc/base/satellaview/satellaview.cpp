@@ -3,7 +3,7 @@
 #define SATELLAVIEW_BASE_UNIT_CPP
 namespace SuperFamicom {
 
-SatellaviewBaseUnit satellaviewbaseunit;
+threadlocal SatellaviewBaseUnit satellaviewbaseunit;
 
 void SatellaviewBaseUnit::init() {
 }
@@ -22,4 +22,4 @@ private:
   } regs;
 };
 
-extern SatellaviewBaseUnit satellaviewbaseunit;
+extern threadlocal SatellaviewBaseUnit satellaviewbaseunit;
@@ -5,7 +5,7 @@ namespace SuperFamicom {
 
 #include "markup.cpp"
 #include "serialization.cpp"
-Cartridge cartridge;
+threadlocal Cartridge cartridge;
 
 string Cartridge::title() {
   if(information.title.gameBoy.empty() == false) {
@@ -47,10 +47,12 @@ struct Cartridge : property<Cartridge> {
     unsigned size;
     unsigned base;
     unsigned mask;
+    MappedRAM* ram;  //read directly from this memory, bypassing reader
 
     Mapping();
     Mapping(const function<uint8 (unsigned)>&, const function<void (unsigned, uint8)>&);
     Mapping(SuperFamicom::Memory&);
+    Mapping(MappedRAM&);
   };
   vector<Mapping> mapping;
 
@@ -120,4 +122,4 @@ private:
   friend class Interface;
 };
 
-extern Cartridge cartridge;
+extern threadlocal Cartridge cartridge;
@@ -588,18 +588,28 @@ void Cartridge::parse_markup_msu1(Markup::Node root) {
 
 Cartridge::Mapping::Mapping() {
   size = base = mask = 0;
+  ram = nullptr;
 }
 
 Cartridge::Mapping::Mapping(SuperFamicom::Memory& memory) {
   reader = {&SuperFamicom::Memory::read,  &memory};
   writer = {&SuperFamicom::Memory::write, &memory};
   size = base = mask = 0;
+  ram = nullptr;
+}
+
+Cartridge::Mapping::Mapping(MappedRAM& memory) {
+  reader = {&SuperFamicom::Memory::read,  (SuperFamicom::Memory*)&memory};
+  writer = {&SuperFamicom::Memory::write, (SuperFamicom::Memory*)&memory};
+  size = base = mask = 0;
+  ram = &memory;
 }
 
 Cartridge::Mapping::Mapping(const function<uint8 (unsigned)>& reader, const function<void (unsigned, uint8)>& writer) {
   this->reader = reader;
   this->writer = writer;
   size = base = mask = 0;
+  ram = nullptr;
 }
 
 #endif
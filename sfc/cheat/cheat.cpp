@@ -4,30 +4,69 @@
 #define CHEAT_CPP
 namespace SuperFamicom {
 
-Cheat cheat;
+threadlocal Cheat cheat;
 
 void Cheat::reset() {
   codes.reset();
+  rebuild();
 }
 
 void Cheat::append(unsigned addr, unsigned data) {
-  codes.append({addr, Unused, data});
+  append(addr, Unused, data);
 }
 
+//a new code only adds its own address to the index
 void Cheat::append(unsigned addr, unsigned comp, unsigned data) {
   codes.append({addr, comp, data});
+  if(bitmap == nullptr) {
+    bitmap = new uint8[(1 << 24) >> 3];
+    memset(bitmap, 0, (1 << 24) >> 3);
+  }
+  insert(codes.size() - 1);
 }
 
-optional<unsigned> Cheat::find(unsigned addr, unsigned comp) {
-  //WRAM mirroring: $00-3f,80-bf:0000-1fff -> $7e:0000-1fff
-  if((addr & 0x40e000) == 0x000000) addr = 0x7e0000 | (addr & 0x1fff);
-
-  for(auto& code : codes) {
-    if(code.addr == addr && (code.comp == Unused || code.comp == comp)) {
-      return {true, code.data};
+optional<unsigned> Cheat::lookup(unsigned addr, unsigned comp) {
+  if(auto entry = index.find({addr})) {
+    for(auto& n : entry().codes) {
+      auto& code = codes[n];
+      if(code.comp == Unused || code.comp == comp) return {true, code.data};
     }
   }
   return false;
 }
 
+void Cheat::rebuild() {
+  index.reset();
+  if(codes.size() == 0) {
+    if(bitmap) delete[] bitmap;
+    bitmap = nullptr;
+    return;
+  }
+
+  if(bitmap == nullptr) bitmap = new uint8[(1 << 24) >> 3];
+  memset(bitmap, 0, (1 << 24) >> 3);
+
+  for(unsigned n = 0; n < codes.size(); n++) insert(n);
+}
+
+void Cheat::insert(unsigned n) {
+  unsigned addr = codes[n].addr;
+  if(addr > 0xffffff) return;  //can never match a bus address
+  bitmap[addr >> 3] |= 1 << (addr & 7);
+
+  if(auto entry = index.find({addr})) {
+    entry().codes.append(n);
+  } else {
+    index.insert({addr, {n}});
+  }
+}
+
+Cheat::Cheat() {
+  bitmap = nullptr;
+}
+
+Cheat::~Cheat() {
+  if(bitmap) delete[] bitmap;
+}
+
 }
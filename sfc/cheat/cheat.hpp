@@ -11,7 +11,36 @@ struct Cheat {
   void reset();
   void append(unsigned addr, unsigned data);
   void append(unsigned addr, unsigned comp, unsigned data);
-  optional<unsigned> find(unsigned addr, unsigned comp);
+  alwaysinline optional<unsigned> find(unsigned addr, unsigned comp);
+
+  Cheat();
+  ~Cheat();
+
+private:
+  //codes are indexed by address (extended on append, rebuilt on reset):
+  //a 24-bit presence bitmap rejects unpatched addresses in O(1),
+  //then a hash table yields the codes for the address in order.
+  struct Index {
+    unsigned addr;
+    vector<unsigned> codes;
+    unsigned hash() const { return addr; }
+    bool operator==(const Index& source) const { return addr == source.addr; }
+  };
+  uint8* bitmap;
+  hashset<Index> index;
+
+  void rebuild();
+  void insert(unsigned n);
+  optional<unsigned> lookup(unsigned addr, unsigned comp);
 };
 
-extern Cheat cheat;
+optional<unsigned> Cheat::find(unsigned addr, unsigned comp) {
+  //WRAM mirroring: $00-3f,80-bf:0000-1fff -> $7e:0000-1fff
+  if((addr & 0x40e000) == 0x000000) addr = 0x7e0000 | (addr & 0x1fff);
+
+  addr &= 0xffffff;
+  if((bitmap[addr >> 3] & (1 << (addr & 7))) == 0) return false;
+  return lookup(addr, comp);
+}
+
+extern threadlocal Cheat cheat;
@@ -5,7 +5,7 @@ namespace SuperFamicom {
 
 #include "memory.cpp"
 #include "serialization.cpp"
-ArmDSP armdsp;
+threadlocal ArmDSP armdsp;
 
 void ArmDSP::Enter() { armdsp.enter(); }
 
@@ -38,10 +38,11 @@ void ArmDSP::enter() {
   }
 }
 
+//with a budget, the ARM only yields once that far ahead, or to access the bridge
 void ArmDSP::step(unsigned clocks) {
   if(bridge.timer) --bridge.timer;
   Coprocessor::step(clocks);
-  synchronize_cpu();
+  if(clock >= (int64)configuration.armdsp_budget * cpu.frequency) synchronize_cpu();
 }
 
 //MMIO: $00-3f|80-bf:3800-38ff
@@ -100,6 +101,7 @@ void ArmDSP::unload() {
 
 void ArmDSP::power() {
   for(unsigned n = 0; n < 16 * 1024; n++) programRAM[n] = random(0x00);
+  arm_cache(0xe0000000, 0x1ffff);  //program ROM, $00000000-1fffffff
 }
 
 void ArmDSP::reset() {
@@ -32,4 +32,4 @@ struct ArmDSP : Processor::ARM, Coprocessor {
   ~ArmDSP();
 };
 
-extern ArmDSP armdsp;
+extern threadlocal ArmDSP armdsp;
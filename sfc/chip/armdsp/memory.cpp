@@ -31,6 +31,7 @@ uint32 ArmDSP::bus_read(uint32 addr, uint32 size) {
   case 0xe0000000: return memory(programRAM, addr & 0x3fff, size);
   }
 
+  synchronize_cpu();
   addr &= 0xe000003f;
 
   if(addr == 0x40000010) {
@@ -77,6 +78,7 @@ void ArmDSP::bus_write(uint32 addr, uint32 size, uint32 word) {
   case 0xe0000000: return memory(programRAM, addr & 0x3fff, size, word);
   }
 
+  synchronize_cpu();
   addr &= 0xe000003f;
   word &= 0x000000ff;
 
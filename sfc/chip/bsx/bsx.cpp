@@ -4,7 +4,7 @@
 namespace SuperFamicom {
 
 #include "serialization.cpp"
-BSXCartridge bsxcartridge;
+threadlocal BSXCartridge bsxcartridge;
 
 void BSXCartridge::init() {
 }
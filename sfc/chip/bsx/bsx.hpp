@@ -31,4 +31,4 @@ private:
   bool r0c, r0d, r0e, r0f;
 };
 
-extern BSXCartridge bsxcartridge;
+extern threadlocal BSXCartridge bsxcartridge;
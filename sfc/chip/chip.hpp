@@ -3,6 +3,90 @@ struct Coprocessor : Thread {
   alwaysinline void synchronize_cpu();
 };
 
+//decompressed output of a chip's data streams, keyed by the start of the stream and whatever
+//state its decoder reads the data ROM through. the ROM never changes, so a stream always decodes
+//to the same words: decoders replay the cached prefix and only run to extend it.
+//the least recently used streams are dropped once the cache outgrows Capacity bytes.
+template<typename T> struct StreamCache {
+  enum : unsigned { Slots = 256, Capacity = 8 << 20 };
+
+  struct Stream {
+    uint64 key;
+    uint64 used;  //0 = slot is free
+    vector<T> data;
+  };
+
+  Stream& open(uint64 key) {
+    Stream* target = &streams[0];
+    for(auto& stream : streams) {
+      if(stream.used && stream.key == key) {
+        stream.used = ++counter;
+        return stream;
+      }
+      if(stream.used < target->used) target = &stream;
+    }
+    size -= target->data.size() * sizeof(T);
+    target->data.reset();
+    target->key = key;
+    target->used = ++counter;
+    return *target;
+  }
+
+  //stream must be the one being decoded: it is never the one evicted
+  void append(Stream& stream, T value) {
+    stream.data.append(value);
+    size += sizeof(T);
+    while(size > Capacity) {
+      Stream* target = nullptr;
+      for(auto& other : streams) {
+        if(&other == &stream || other.data.empty()) continue;
+        if(!target || other.used < target->used) target = &other;
+      }
+      if(!target) break;
+      size -= target->data.size() * sizeof(T);
+      target->data.reset();
+      target->used = 0;
+    }
+  }
+
+  void reset() {
+    for(auto& stream : streams) stream.data.reset(), stream.used = 0;
+    counter = 0;
+    size = 0;
+  }
+
+  //an index lists streams (key, length) to decompress ahead of time when the game is loaded.
+  //it is only rewritten on unload if it already existed, so creating an empty file opts in.
+  void load(const string& filename, const function<void (uint64, unsigned)>& decode) {
+    indexname = "";
+    file fp;
+    if(fp.open(filename, file::mode::read) == false) return;
+    indexname = filename;
+    while(fp.size() - fp.offset() >= 12) {
+      uint64 key = fp.readl(8);
+      unsigned length = fp.readl(4);
+      decode(key, min(length, (unsigned)(Capacity / sizeof(T))));
+    }
+  }
+
+  void save() {
+    if(indexname.empty()) return;
+    file fp;
+    if(fp.open(indexname, file::mode::write) == false) return;
+    for(auto& stream : streams) {
+      if(stream.data.empty()) continue;
+      fp.writel(stream.key, 8);
+      fp.writel(stream.data.size(), 4);
+    }
+  }
+
+private:
+  Stream streams[Slots];
+  uint64 counter = 0;
+  unsigned size = 0;  //bytes of output held
+  string indexname;
+};
+
 #include <sfc/chip/icd2/icd2.hpp>
 #include <sfc/chip/bsx/bsx.hpp>
 #include <sfc/chip/nss/nss.hpp>
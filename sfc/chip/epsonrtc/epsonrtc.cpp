@@ -6,7 +6,7 @@ namespace SuperFamicom {
 #include "memory.cpp"
 #include "time.cpp"
 #include "serialization.cpp"
-EpsonRTC epsonrtc;
+threadlocal EpsonRTC epsonrtc;
 
 void EpsonRTC::Enter() {
   epsonrtc.enter();
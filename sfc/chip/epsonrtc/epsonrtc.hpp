@@ -88,4 +88,4 @@ struct EpsonRTC : Coprocessor {
   void tick_year();
 };
 
-extern EpsonRTC epsonrtc;
+extern threadlocal EpsonRTC epsonrtc;
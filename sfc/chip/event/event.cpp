@@ -3,7 +3,7 @@
 #define EVENT_CPP
 namespace SuperFamicom {
 
-Event event;
+threadlocal Event event;
 
 void Event::Enter() { event.enter(); }
 
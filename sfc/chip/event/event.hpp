@@ -41,4 +41,4 @@ struct Event : Coprocessor {
   bool usedSaveState;
 };
 
-extern Event event;
+extern threadlocal Event event;
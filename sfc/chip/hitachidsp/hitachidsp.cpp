@@ -5,7 +5,7 @@ namespace SuperFamicom {
 
 #include "memory.cpp"
 #include "serialization.cpp"
-HitachiDSP hitachidsp;
+threadlocal HitachiDSP hitachidsp;
 
 void HitachiDSP::Enter() { hitachidsp.enter(); }
 
@@ -36,4 +36,4 @@ struct HitachiDSP : Processor::HG51B, Coprocessor {
   void serialize(serializer&);
 };
 
-extern HitachiDSP hitachidsp;
+extern threadlocal HitachiDSP hitachidsp;
@@ -4,7 +4,7 @@
 namespace SuperFamicom {
 
 #include "serialization.cpp"
-HSU1 hsu1;
+threadlocal HSU1 hsu1;
 
 void HSU1::init() {
 }
@@ -18,4 +18,4 @@ private:
   vector<uint8> rxbuffer;
 };
 
-extern HSU1 hsu1;
+extern threadlocal HSU1 hsu1;
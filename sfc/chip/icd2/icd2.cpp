@@ -6,7 +6,7 @@ namespace SuperFamicom {
 #include "interface/interface.cpp"
 #include "mmio/mmio.cpp"
 #include "serialization.cpp"
-ICD2 icd2;
+threadlocal ICD2 icd2;
 
 void ICD2::Enter() { icd2.enter(); }
 
@@ -22,4 +22,4 @@ private:
   #include "mmio/mmio.hpp"
 };
 
-extern ICD2 icd2;
+extern threadlocal ICD2 icd2;
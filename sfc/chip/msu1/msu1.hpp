@@ -45,4 +45,4 @@ private:
   } mmio;
 };
 
-extern MSU1 msu1;
+extern threadlocal MSU1 msu1;
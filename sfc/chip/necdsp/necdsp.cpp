@@ -4,7 +4,7 @@
 namespace SuperFamicom {
 
 #include "serialization.cpp"
-NECDSP necdsp;
+threadlocal NECDSP necdsp;
 
 void NECDSP::Enter() { necdsp.enter(); }
 
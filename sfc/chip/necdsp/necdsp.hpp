@@ -20,4 +20,4 @@ struct NECDSP : Processor::uPD96050, Coprocessor {
   void serialize(serializer&);
 };
 
-extern NECDSP necdsp;
+extern threadlocal NECDSP necdsp;
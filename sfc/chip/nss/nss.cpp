@@ -3,7 +3,7 @@
 #define NSS_CPP
 namespace SuperFamicom {
 
-NSS nss;
+threadlocal NSS nss;
 
 void NSS::init() {
   dip = 0x00;
@@ -12,4 +12,4 @@ struct NSS {
   void write(unsigned addr, uint8 data);
 };
 
-extern NSS nss;
+extern threadlocal NSS nss;
@@ -4,7 +4,7 @@
 namespace SuperFamicom {
 
 #include "serialization.cpp"
-OBC1 obc1;
+threadlocal OBC1 obc1;
 
 void OBC1::init() {
 }
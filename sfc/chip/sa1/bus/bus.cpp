@@ -8,11 +8,13 @@ unsigned SA1::CPUIRAM::size() const {
 
 uint8 SA1::CPUIRAM::read(unsigned addr) {
   cpu.synchronize_coprocessors();
+  sa1.shared.iram[(addr & 0x07ff) >> 8] = sa1.shared.frame;
   return sa1.iram.read(addr & 0x07ff);
 }
 
 void SA1::CPUIRAM::write(unsigned addr, uint8 data) {
   cpu.synchronize_coprocessors();
+  sa1.shared.iram[(addr & 0x07ff) >> 8] = sa1.shared.frame;
   sa1.iram.write(addr & 0x07ff, data);
 }
 
@@ -22,12 +24,14 @@ unsigned SA1::CPUBWRAM::size() const {
 
 uint8 SA1::CPUBWRAM::read(unsigned addr) {
   cpu.synchronize_coprocessors();
+  sa1.shared.bwram[((addr & (sa1.bwram.size() - 1)) >> 8) & 1023] = sa1.shared.frame;
   if(dma) return sa1.dma_cc1_read(addr);
   return sa1.bwram.read(addr);
 }
 
 void SA1::CPUBWRAM::write(unsigned addr, uint8 data) {
   cpu.synchronize_coprocessors();
+  sa1.shared.bwram[((addr & (sa1.bwram.size() - 1)) >> 8) & 1023] = sa1.shared.frame;
   sa1.bwram.write(addr, data);
 }
 
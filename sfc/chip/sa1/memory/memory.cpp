@@ -18,22 +18,22 @@ uint8 SA1::bus_read(unsigned addr) {
   }
 
   if((addr & 0x40f800) == 0x000000) {  //$00-3f|80-bf:0000-07ff
-    synchronize_cpu();
+    synchronize_iram(addr & 2047);
     return iram.read(addr & 2047);
   }
 
   if((addr & 0x40f800) == 0x003000) {  //$00-3f|80-bf:3000-37ff
-    synchronize_cpu();
+    synchronize_iram(addr & 2047);
     return iram.read(addr & 2047);
   }
 
   if((addr & 0xf00000) == 0x400000) {  //$40-4f:0000-ffff
-    synchronize_cpu();
+    synchronize_bwram(addr & (bwram.size() - 1));
     return bwram.read(addr & (bwram.size() - 1));
   }
 
   if((addr & 0xf00000) == 0x600000) {  //$60-6f:0000-ffff
-    synchronize_cpu();
+    synchronize_bitmap(addr & 0x0fffff);
     return bitmap_read(addr & 0x0fffff);
   }
 
@@ -51,22 +51,22 @@ void SA1::bus_write(unsigned addr, uint8 data) {
   }
 
   if((addr & 0x40f800) == 0x000000) {  //$00-3f|80-bf:0000-07ff
-    synchronize_cpu();
+    synchronize_iram(addr & 2047);
     return iram.write(addr & 2047, data);
   }
 
   if((addr & 0x40f800) == 0x003000) {  //$00-3f|80-bf:3000-37ff
-    synchronize_cpu();
+    synchronize_iram(addr & 2047);
     return iram.write(addr & 2047, data);
   }
 
   if((addr & 0xf00000) == 0x400000) {  //$40-4f:0000-ffff
-    synchronize_cpu();
+    synchronize_bwram(addr & (bwram.size() - 1));
     return bwram.write(addr & (bwram.size() - 1), data);
   }
 
   if((addr & 0xf00000) == 0x600000) {  //$60-6f:0000-ffff
-    synchronize_cpu();
+    synchronize_bitmap(addr & 0x0fffff);
     return bitmap_write(addr & 0x0fffff, data);
   }
 }
@@ -210,27 +210,29 @@ void SA1::mmcbwram_write(unsigned addr, uint8 data) {
 }
 
 uint8 SA1::mmc_sa1_read(unsigned addr) {
-  synchronize_cpu();
   if(mmio.sw46 == 0) {
     //$40-43:0000-ffff x  32 projection
     addr = bus.mirror((mmio.cbm & 0x1f) * 0x2000 + (addr & 0x1fff), bwram.size());
+    synchronize_bwram(addr);
     return bwram.read(addr);
   } else {
     //$60-6f:0000-ffff x 128 projection
     addr = bus.mirror(mmio.cbm * 0x2000 + (addr & 0x1fff), 0x100000);
+    synchronize_bitmap(addr);
     return bitmap_read(addr);
   }
 }
 
 void SA1::mmc_sa1_write(unsigned addr, uint8 data) {
-  synchronize_cpu();
   if(mmio.sw46 == 0) {
     //$40-43:0000-ffff x  32 projection
     addr = bus.mirror((mmio.cbm & 0x1f) * 0x2000 + (addr & 0x1fff), bwram.size());
+    synchronize_bwram(addr);
     bwram.write(addr, data);
   } else {
     //$60-6f:0000-ffff x 128 projection
     addr = bus.mirror(mmio.cbm * 0x2000 + (addr & 0x1fff), 0x100000);
+    synchronize_bitmap(addr);
     bitmap_write(addr, data);
   }
 }
@@ -3,7 +3,7 @@
 #define SA1_CPP
 namespace SuperFamicom {
 
-SA1 sa1;
+threadlocal SA1 sa1;
 
 #include "serialization.cpp"
 #include "bus/bus.cpp"
@@ -82,7 +82,7 @@ bool SA1::interrupt_pending() {
 
 void SA1::tick() {
   step(2);
-  if(++status.tick_counter == 0) synchronize_cpu();
+  if(++status.tick_counter == 0) synchronize_budget();
 
   //adjust counters:
   //note that internally, status counters are in clocks;
@@ -111,6 +111,32 @@ void SA1::tick() {
   }
 }
 
+void SA1::synchronize_shared(uint8 stamp) {
+  if((uint8)(shared.frame - stamp) > 1) return synchronize_budget();
+  synchronize_cpu();
+}
+
+//with no budget, this is synchronize_cpu()
+void SA1::synchronize_budget() {
+  if(clock >= (int64)configuration.sa1_budget * cpu.frequency) synchronize_cpu();
+}
+
+void SA1::synchronize_iram(unsigned addr) {
+  synchronize_shared(shared.iram[addr >> 8]);
+}
+
+void SA1::synchronize_bwram(unsigned addr) {
+  synchronize_shared(shared.bwram[(addr >> 8) & 1023]);
+}
+
+void SA1::synchronize_bitmap(unsigned addr) {
+  synchronize_bwram((addr >> (mmio.bbf == 0 ? 1 : 2)) & (bwram.size() - 1));
+}
+
+void SA1::frame() {
+  shared.frame++;
+}
+
 void SA1::trigger_irq() {
   mmio.timer_irqfl = true;
   if(mmio.timer_irqen) mmio.timer_irqcl = 0;
@@ -156,6 +182,11 @@ void SA1::reset() {
 
   status.tick_counter = 0;
 
+  //stamps two or more frames old mark pages the S-CPU has not accessed
+  shared.frame = 0;
+  memset(shared.iram, 0x80, sizeof shared.iram);
+  memset(shared.bwram, 0x80, sizeof shared.bwram);
+
   status.interrupt_pending = false;
 
   status.scanlines = (system.region() == System::Region::NTSC ? 262 : 312);
@@ -18,6 +18,22 @@ struct SA1 : Processor::R65816, public Coprocessor {
     uint16 hcounter;
   } status;
 
+  //relaxed synchronization (configuration.sa1_budget > 0): S-CPU accesses stamp each
+  //256-byte page of I-RAM and BW-RAM with the current frame number. pages not stamped
+  //this frame or the last are assumed private to the SA-1, which then keeps running
+  //on them until it is the budget ahead of the S-CPU
+  struct Shared {
+    uint8 frame;
+    uint8 iram[2048 >> 8];
+    uint8 bwram[0x40000 >> 8];
+  } shared;
+
+  alwaysinline void synchronize_shared(uint8 stamp);
+  alwaysinline void synchronize_budget();
+  alwaysinline void synchronize_iram(unsigned addr);
+  alwaysinline void synchronize_bwram(unsigned addr);
+  alwaysinline void synchronize_bitmap(unsigned addr);
+
   static void Enter();
   void enter();
   void tick();
@@ -27,6 +43,8 @@ struct SA1 : Processor::R65816, public Coprocessor {
   alwaysinline void last_cycle();
   alwaysinline bool interrupt_pending();
 
+  void frame();
+
   void init();
   void load();
   void unload();
@@ -36,4 +54,4 @@ struct SA1 : Processor::R65816, public Coprocessor {
   void serialize(serializer&);
 };
 
-extern SA1 sa1;
+extern threadlocal SA1 sa1;
@@ -16,6 +16,10 @@ void SA1::serialize(serializer& s) {
   s.integer(status.vcounter);
   s.integer(status.hcounter);
 
+  s.integer(shared.frame);
+  s.array(shared.iram);
+  s.array(shared.bwram);
+
   //bus/bus.hpp
   s.array(iram.data(), iram.size());
 
@@ -261,6 +261,24 @@ uint8 SDD1::Decomp::OL::decompress() {
 //core
 
 void SDD1::Decomp::init(unsigned offset) {
+  key = offset & 0xffffff;
+  for(unsigned n = 0; n < 4; n++) key |= (uint64)(sdd1.mmc[n] >> 20 & 0xff) << (24 + n * 8);
+  stream = &cache.open(key);
+  position = 0;
+  restart(offset);
+}
+
+uint8 SDD1::Decomp::read() {
+  if(position < stream->data.size()) return stream->data.data()[position++];
+  while(decoded < position) ol.decompress(), decoded++;
+  uint8 data = ol.decompress();
+  decoded++;
+  if(stream->data.size() == position) cache.append(*stream, data);
+  position++;
+  return data;
+}
+
+void SDD1::Decomp::restart(unsigned offset) {
   im.init(offset);
   bg0.init();
   bg1.init();
@@ -273,10 +291,7 @@ void SDD1::Decomp::init(unsigned offset) {
   pem.init();
   cm.init(offset);
   ol.init(offset);
-}
-
-uint8 SDD1::Decomp::read() {
-  return ol.decompress();
+  decoded = 0;
 }
 
 SDD1::Decomp::Decomp():
@@ -70,8 +70,16 @@ struct Decomp {
 
   void init(unsigned offset);
   uint8 read();
+  void restart(unsigned offset);
   Decomp();
 
+  //output is replayed from the cache; the decoder only runs past what is cached for a stream
+  StreamCache<uint8> cache;
+  StreamCache<uint8>::Stream* stream = nullptr;
+  uint64 key = 0;         //offset and MMC banks of the current stream
+  unsigned position = 0;  //bytes of the stream returned by read()
+  unsigned decoded = 0;   //bytes of the stream produced by the decoder
+
   IM  im;
   GCD gcd;
   BG  bg0, bg1, bg2, bg3, bg4, bg5, bg6, bg7;
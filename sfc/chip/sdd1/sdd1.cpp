@@ -3,7 +3,7 @@
 #define SDD1_CPP
 namespace SuperFamicom {
 
-SDD1 sdd1;
+threadlocal SDD1 sdd1;
 
 #include "decomp.cpp"
 #include "serialization.cpp"
@@ -16,9 +16,18 @@ void SDD1::load() {
   //buffer address and transfer size information for use in SDD1::mcu_read()
   bus.map({&SDD1::read, &sdd1}, {&SDD1::write, &sdd1}, 0x00, 0x3f, 0x4300, 0x437f);
   bus.map({&SDD1::read, &sdd1}, {&SDD1::write, &sdd1}, 0x80, 0xbf, 0x4300, 0x437f);
+
+  //named after the game, as several games may share a directory
+  decomp.cache.load({interface->path(ID::SuperFamicom), cartridge.sha256(), ".sdd1.idx"}, [&](uint64 key, unsigned length) {
+    for(unsigned n = 0; n < 4; n++) mmc[n] = (key >> (24 + n * 8) & 0xff) << 20;
+    decomp.init(key & 0xffffff);
+    while(length--) decomp.read();
+  });
 }
 
 void SDD1::unload() {
+  decomp.cache.save();
+  decomp.cache.reset();
   rom.reset();
   ram.reset();
 }
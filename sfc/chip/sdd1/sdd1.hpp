@@ -37,4 +37,4 @@ public:
   Decomp decomp;
 };
 
-extern SDD1 sdd1;
+extern threadlocal SDD1 sdd1;
@@ -6,7 +6,7 @@ namespace SuperFamicom {
 #include "memory.cpp"
 #include "time.cpp"
 #include "serialization.cpp"
-SharpRTC sharprtc;
+threadlocal SharpRTC sharprtc;
 
 void SharpRTC::Enter() {
   sharprtc.enter();
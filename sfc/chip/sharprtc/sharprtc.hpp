@@ -44,4 +44,4 @@ struct SharpRTC : Coprocessor {
   unsigned calculate_weekday(unsigned year, unsigned month, unsigned day);
 };
 
-extern SharpRTC sharprtc;
+extern threadlocal SharpRTC sharprtc;
@@ -15,7 +15,7 @@ void SPC7110::dcu_begin_transfer() {
   if(dcu_mode == 3) return;  //invalid mode
 
   add_clocks(20);
-  decompressor->initialize(dcu_mode, dcu_addr);
+  decompressor->initialize(dcu_mode, dcu_addr, r4834 & 3);
   decompressor->decode();
 
   unsigned seek = r480b & 2 ? r4805 | r4806 << 8 : 0;
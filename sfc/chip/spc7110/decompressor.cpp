@@ -32,10 +32,30 @@ struct Decompressor {
     return list;
   }
 
-  void initialize(unsigned mode, unsigned origin) {
+  //mapping is the data ROM size setting (r4834 & 3) the stream is read through
+  void initialize(unsigned mode, unsigned origin, unsigned mapping) {
+    key = (origin & 0x7fffff) | mode << 23 | mapping << 25;  //the data ROM is read through 23 address bits
+    stream = &cache.open(key);
+    position = 0;
+    restart();
+  }
+
+  //the decoder only runs past the output already cached for this stream
+  void decode() {
+    if(position < stream->data.size()) {
+      result = stream->data.data()[position++];
+      return;
+    }
+    while(decoded < position) run();
+    run();
+    if(stream->data.size() == position) cache.append(*stream, result);
+    position++;
+  }
+
+  void restart() {
     for(auto &root : context) for(auto &node : root) node = {0, 0};
-    bpp = 1 << mode;
-    offset = origin;
+    bpp = 1 << (key >> 23 & 3);
+    offset = key & 0x7fffff;
     bits = 8;
     range = Max + 1;
     input = read();
@@ -43,9 +63,10 @@ struct Decompressor {
     output = 0;
     pixels = 0;
     colormap = 0xfedcba9876543210ull;
+    decoded = 0;
   }
 
-  void decode() {
+  void run() {
     for(unsigned pixel = 0; pixel < 8; pixel++) {
       uint64 map = colormap;
       unsigned diff = 0;
@@ -117,6 +138,7 @@ struct Decompressor {
     if(bpp == 1) result = pixels;
     if(bpp == 2) result = deinterleave(pixels, 16);
     if(bpp == 4) result = deinterleave(deinterleave(pixels, 32), 32);
+    decoded++;
   }
 
   void serialize(serializer& s) {
@@ -136,6 +158,11 @@ struct Decompressor {
     s.integer(pixels);
     s.integer(colormap);
     s.integer(result);
+
+    s.integer(key);
+    s.integer(position);
+    s.integer(decoded);
+    if(s.mode() == serializer::Load) stream = &cache.open(key);
   }
 
   enum : unsigned { MPS = 0, LPS = 1 };
@@ -161,6 +188,12 @@ struct Decompressor {
   uint64 pixels;
   uint64 colormap;      //most recently used list
   uint32 result;        //decompressed word after calling decode()
+
+  StreamCache<uint32> cache;
+  StreamCache<uint32>::Stream* stream = nullptr;
+  uint32 key = 0;         //mode, origin and mapping of the current stream
+  unsigned position = 0;  //words of the stream returned by decode()
+  unsigned decoded = 0;   //words of the stream produced by the decoder
 };
 
 Decompressor::ModelState Decompressor::evolution[53] = {
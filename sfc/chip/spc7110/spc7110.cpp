@@ -7,7 +7,7 @@ namespace SuperFamicom {
 #include "data.cpp"
 #include "alu.cpp"
 #include "serialization.cpp"
-SPC7110 spc7110;
+threadlocal SPC7110 spc7110;
 
 SPC7110::SPC7110() {
   decompressor = new Decompressor(*this);
@@ -42,9 +42,17 @@ void SPC7110::init() {
 }
 
 void SPC7110::load() {
+  //named after the game, as several games may share a directory
+  decompressor->cache.load({interface->path(ID::SuperFamicom), cartridge.sha256(), ".spc7110.idx"}, [&](uint64 key, unsigned length) {
+    r4834 = key >> 25;
+    decompressor->initialize(key >> 23 & 3, key & 0x7fffff, key >> 25);
+    while(length--) decompressor->decode();
+  });
 }
 
 void SPC7110::unload() {
+  decompressor->cache.save();
+  decompressor->cache.reset();
   prom.reset();
   drom.reset();
   ram.reset();
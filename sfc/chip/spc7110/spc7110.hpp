@@ -128,4 +128,4 @@ private:
   uint8 r4834;  //bank mapping settings
 };
 
-extern SPC7110 spc7110;
+extern threadlocal SPC7110 spc7110;
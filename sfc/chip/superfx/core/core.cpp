@@ -73,6 +73,17 @@ uint8 SuperFX::rpix(uint8 x, uint8 y) {
   return data;
 }
 
+//plotting always targets game pack RAM: while the GSU owns it, bypass bus_read() / bus_write()
+uint8 SuperFX::pixelcache_read(unsigned addr) {
+  if(regs.scmr.ran) return ram.data()[addr & ram_mask];
+  return bus_read(addr);
+}
+
+void SuperFX::pixelcache_write(unsigned addr, uint8 data) {
+  if(regs.scmr.ran) ram.data()[addr & ram_mask] = data;
+  else bus_write(addr, data);
+}
+
 void SuperFX::pixelcache_flush(pixelcache_t& cache) {
   if(cache.bitpend == 0x00) return;
 
@@ -89,17 +100,23 @@ void SuperFX::pixelcache_flush(pixelcache_t& cache) {
   unsigned bpp = 2 << (regs.scmr.md - (regs.scmr.md >> 1));  // = [regs.scmr.md]{ 2, 4, 4, 8 };
   unsigned addr = 0x700000 + (cn * (bpp << 3)) + (regs.scbr << 10) + ((y & 0x07) * 2);
 
+  //transpose the 8x8 bit matrix of pixels, so that byte n of planes holds bit n of each pixel
+  uint64 planes = 0;
+  for(unsigned x = 0; x < 8; x++) planes |= (uint64)cache.data[x] << (x << 3);
+  planes = (planes & 0xaa55aa55aa55aa55ull) | ((planes & 0x00aa00aa00aa00aaull) << 7) | ((planes >> 7) & 0x00aa00aa00aa00aaull);
+  planes = (planes & 0xcccc3333cccc3333ull) | ((planes & 0x0000cccc0000ccccull) << 14) | ((planes >> 14) & 0x0000cccc0000ccccull);
+  planes = (planes & 0xf0f0f0f00f0f0f0full) | ((planes & 0x00000000f0f0f0f0ull) << 28) | ((planes >> 28) & 0x00000000f0f0f0f0ull);
+
   for(unsigned n = 0; n < bpp; n++) {
     unsigned byte = ((n >> 1) << 4) + (n & 1);  // = [n]{ 0, 1, 16, 17, 32, 33, 48, 49 };
-    uint8 data = 0x00;
-    for(unsigned x = 0; x < 8; x++) data |= ((cache.data[x] >> n) & 1) << x;
+    uint8 data = planes >> (n << 3);
     if(cache.bitpend != 0xff) {
       step(memory_access_speed);
       data &= cache.bitpend;
-      data |= bus_read(addr + byte) & ~cache.bitpend;
+      data |= pixelcache_read(addr + byte) & ~cache.bitpend;
     }
     step(memory_access_speed);
-    bus_write(addr + byte, data);
+    pixelcache_write(addr + byte, data);
   }
 
   cache.bitpend = 0x00;
@@ -3,3 +3,5 @@ uint8 color(uint8 source);
 void plot(uint8 x, uint8 y);
 uint8 rpix(uint8 x, uint8 y);
 void pixelcache_flush(pixelcache_t& cache);
+alwaysinline uint8 pixelcache_read(unsigned addr);
+alwaysinline void pixelcache_write(unsigned addr, uint8 data);
@@ -78,7 +78,7 @@ uint8 SuperFX::peekpipe() {
 
 uint8 SuperFX::pipe() {
   uint8 result = regs.pipeline;
-  regs.pipeline = op_read(++regs.r[15]);
+  regs.pipeline = op_read(++regs.r[15].data);
   r15_modified = false;
   return result;
 }
@@ -11,7 +11,7 @@ namespace SuperFamicom {
 #include "timing/timing.cpp"
 #include "disassembler/disassembler.cpp"
 
-SuperFX superfx;
+threadlocal SuperFX superfx;
 
 void SuperFX::Enter() { superfx.enter(); }
 
@@ -22,13 +22,17 @@ void SuperFX::enter() {
     }
 
     if(regs.sfr.g == 0) {
-      step(6);
+      //only an S-CPU write can set GO again, and that synchronizes the GSU first:
+      //so idle time up to the S-CPU is skipped at once, in the same 6-clock units
+      int64 lag = -clock;
+      unsigned steps = lag > 0 ? (lag - 1) / (6 * (int64)cpu.frequency) + 1 : 1;
+      step(6 * steps);
       synchronize_cpu();
       continue;
     }
 
-    (this->*opcode_table[(regs.sfr & 0x0300) + peekpipe()])();
-    if(r15_modified == false) regs.r[15]++;
+    (this->*opcode_table[(regs.sfr.alt2 << 9) + (regs.sfr.alt1 << 8) + peekpipe()])();
+    if(r15_modified == false) regs.r[15].data++;  //sequential fetch: bypasses r15_modify()
 
     if(++instruction_counter >= 128) {
       instruction_counter = 0;
@@ -23,4 +23,4 @@ privileged:
   unsigned instruction_counter;
 };
 
-extern SuperFX superfx;
+extern threadlocal SuperFX superfx;
@@ -145,4 +145,4 @@ privileged:
   } debugger;
 };
 
-extern CPU cpu;
+extern threadlocal CPU cpu;
@@ -3,7 +3,7 @@
 #define DSP_CPP
 namespace SuperFamicom {
 
-DSP dsp;
+threadlocal DSP dsp;
 
 #define REG(n) state.regs[r_##n]
 #define VREG(n) state.regs[v.vidx + v_##n]
@@ -31,170 +31,46 @@ void DSP::synchronize_smp() {
   }
 }
 
-void DSP::Enter() { dsp.enter(); }
-
+//runs one of the 32 clock steps that make up each output sample;
+//driven as a plain function from SMP::synchronize_dsp() rather than as a thread
 void DSP::enter() {
-  while(true) {
-    if(scheduler.sync == Scheduler::SynchronizeMode::All) {
-      scheduler.exit(Scheduler::ExitReason::SynchronizeEvent);
-    }
-
-    voice_5(voice[0]);
-    voice_2(voice[1]);
-    tick();
-
-    voice_6(voice[0]);
-    voice_3(voice[1]);
-    tick();
-
-    voice_7(voice[0]);
-    voice_4(voice[1]);
-    voice_1(voice[3]);
-    tick();
-
-    voice_8(voice[0]);
-    voice_5(voice[1]);
-    voice_2(voice[2]);
-    tick();
-
-    voice_9(voice[0]);
-    voice_6(voice[1]);
-    voice_3(voice[2]);
-    tick();
-
-    voice_7(voice[1]);
-    voice_4(voice[2]);
-    voice_1(voice[4]);
-    tick();
-
-    voice_8(voice[1]);
-    voice_5(voice[2]);
-    voice_2(voice[3]);
-    tick();
-
-    voice_9(voice[1]);
-    voice_6(voice[2]);
-    voice_3(voice[3]);
-    tick();
-
-    voice_7(voice[2]);
-    voice_4(voice[3]);
-    voice_1(voice[5]);
-    tick();
-
-    voice_8(voice[2]);
-    voice_5(voice[3]);
-    voice_2(voice[4]);
-    tick();
-
-    voice_9(voice[2]);
-    voice_6(voice[3]);
-    voice_3(voice[4]);
-    tick();
-
-    voice_7(voice[3]);
-    voice_4(voice[4]);
-    voice_1(voice[6]);
-    tick();
-
-    voice_8(voice[3]);
-    voice_5(voice[4]);
-    voice_2(voice[5]);
-    tick();
-
-    voice_9(voice[3]);
-    voice_6(voice[4]);
-    voice_3(voice[5]);
-    tick();
-
-    voice_7(voice[4]);
-    voice_4(voice[5]);
-    voice_1(voice[7]);
-    tick();
-
-    voice_8(voice[4]);
-    voice_5(voice[5]);
-    voice_2(voice[6]);
-    tick();
-
-    voice_9(voice[4]);
-    voice_6(voice[5]);
-    voice_3(voice[6]);
-    tick();
-
-    voice_1(voice[0]);
-    voice_7(voice[5]);
-    voice_4(voice[6]);
-    tick();
-
-    voice_8(voice[5]);
-    voice_5(voice[6]);
-    voice_2(voice[7]);
-    tick();
-
-    voice_9(voice[5]);
-    voice_6(voice[6]);
-    voice_3(voice[7]);
-    tick();
-
-    voice_1(voice[1]);
-    voice_7(voice[6]);
-    voice_4(voice[7]);
-    tick();
-
-    voice_8(voice[6]);
-    voice_5(voice[7]);
-    voice_2(voice[0]);
-    tick();
-
-    voice_3a(voice[0]);
-    voice_9(voice[6]);
-    voice_6(voice[7]);
-    echo_22();
-    tick();
-
-    voice_7(voice[7]);
-    echo_23();
-    tick();
-
-    voice_8(voice[7]);
-    echo_24();
-    tick();
-
-    voice_3b(voice[0]);
-    voice_9(voice[7]);
-    echo_25();
-    tick();
-
-    echo_26();
-    tick();
-
-    misc_27();
-    echo_27();
-    tick();
-
-    misc_28();
-    echo_28();
-    tick();
-
-    misc_29();
-    echo_29();
-    tick();
-
-    misc_30();
-    voice_3c(voice[0]);
-    echo_30();
-    tick();
-
-    voice_4(voice[0]);
-    voice_1(voice[2]);
-    tick();
+  switch(state.phase) {
+  case  0: voice_5(voice[0]); voice_2(voice[1]); break;
+  case  1: voice_6(voice[0]); voice_3(voice[1]); break;
+  case  2: voice_7(voice[0]); voice_4(voice[1]); voice_1(voice[3]); break;
+  case  3: voice_8(voice[0]); voice_5(voice[1]); voice_2(voice[2]); break;
+  case  4: voice_9(voice[0]); voice_6(voice[1]); voice_3(voice[2]); break;
+  case  5: voice_7(voice[1]); voice_4(voice[2]); voice_1(voice[4]); break;
+  case  6: voice_8(voice[1]); voice_5(voice[2]); voice_2(voice[3]); break;
+  case  7: voice_9(voice[1]); voice_6(voice[2]); voice_3(voice[3]); break;
+  case  8: voice_7(voice[2]); voice_4(voice[3]); voice_1(voice[5]); break;
+  case  9: voice_8(voice[2]); voice_5(voice[3]); voice_2(voice[4]); break;
+  case 10: voice_9(voice[2]); voice_6(voice[3]); voice_3(voice[4]); break;
+  case 11: voice_7(voice[3]); voice_4(voice[4]); voice_1(voice[6]); break;
+  case 12: voice_8(voice[3]); voice_5(voice[4]); voice_2(voice[5]); break;
+  case 13: voice_9(voice[3]); voice_6(voice[4]); voice_3(voice[5]); break;
+  case 14: voice_7(voice[4]); voice_4(voice[5]); voice_1(voice[7]); break;
+  case 15: voice_8(voice[4]); voice_5(voice[5]); voice_2(voice[6]); break;
+  case 16: voice_9(voice[4]); voice_6(voice[5]); voice_3(voice[6]); break;
+  case 17: voice_1(voice[0]); voice_7(voice[5]); voice_4(voice[6]); break;
+  case 18: voice_8(voice[5]); voice_5(voice[6]); voice_2(voice[7]); break;
+  case 19: voice_9(voice[5]); voice_6(voice[6]); voice_3(voice[7]); break;
+  case 20: voice_1(voice[1]); voice_7(voice[6]); voice_4(voice[7]); break;
+  case 21: voice_8(voice[6]); voice_5(voice[7]); voice_2(voice[0]); break;
+  case 22: voice_3a(voice[0]); voice_9(voice[6]); voice_6(voice[7]); echo_22(); break;
+  case 23: voice_7(voice[7]); echo_23(); break;
+  case 24: voice_8(voice[7]); echo_24(); break;
+  case 25: voice_3b(voice[0]); voice_9(voice[7]); echo_25(); break;
+  case 26: echo_26(); break;
+  case 27: misc_27(); echo_27(); break;
+  case 28: misc_28(); echo_28(); break;
+  case 29: misc_29(); echo_29(); break;
+  case 30: misc_30(); voice_3c(voice[0]); echo_30(); break;
+  case 31: voice_4(voice[0]); voice_1(voice[2]); break;
   }
-}
 
-void DSP::tick() {
+  state.phase = (state.phase + 1) & 31;
   step(3 * 8);
-  synchronize_smp();
 }
 
 /* register interface for S-SMP $00f2,$00f3 */
@@ -284,7 +160,9 @@ void DSP::power() {
 }
 
 void DSP::reset() {
-  create(Enter, system.apu_frequency());
+  Thread::frequency = system.apu_frequency();
+  Thread::clock = 0;
+  state.phase = 0;
 
   REG(flg) = 0xe0;
 
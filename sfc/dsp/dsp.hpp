@@ -1,5 +1,5 @@
 struct DSP : Thread {
-  enum : bool { Threaded = true };
+  enum : bool { Threaded = false };
   alwaysinline void step(unsigned clocks);
   alwaysinline void synchronize_smp();
 
@@ -96,6 +96,8 @@ privileged:
     int t_main_out[2];
     int t_echo_out[2];
     int t_echo_in [2];
+
+    unsigned phase;  //which of the 32 clock steps of the current sample runs next
   } state;
 
   //voice state
@@ -167,9 +169,6 @@ privileged:
   void echo_29();
   void echo_30();
 
-  //dsp
-  static void Enter();
-  void tick();
 };
 
-extern DSP dsp;
+extern threadlocal DSP dsp;
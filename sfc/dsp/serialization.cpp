@@ -47,6 +47,8 @@ void DSP::serialize(serializer& s) {
   s.integer(state.t_echo_in [0]);
   s.integer(state.t_echo_in [1]);
 
+  s.integer(state.phase);
+
   for(unsigned n = 0; n < 8; n++) {
     voice[n].buffer.serialize(s);
     s.integer(voice[n].buf_pos);
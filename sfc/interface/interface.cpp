@@ -2,7 +2,7 @@
 
 namespace SuperFamicom {
 
-Interface* interface = nullptr;
+threadlocal Interface* interface = nullptr;
 
 string Interface::title() {
   return cartridge.title();
@@ -219,6 +219,27 @@ void Interface::load(unsigned id, const stream& stream) {
   if(id == ID::SufamiTurboSlotBRAM) sufamiturboB.ram.read(stream);
 }
 
+//maps a ROM image directly instead of loading a copy with load(id, stream):
+//data must stay valid and unmodified until the cartridge is unloaded.
+//returns false when id is not a ROM, or the image is smaller than the ROM; load() is then required.
+bool Interface::share(unsigned id, const uint8* data, unsigned size) {
+  MappedRAM* memory = nullptr;
+  if(id == ID::ROM) memory = &cartridge.rom;
+  if(id == ID::SA1ROM) memory = &sa1.rom;
+  if(id == ID::SuperFXROM) memory = &superfx.rom;
+  if(id == ID::HitachiDSPROM) memory = &hitachidsp.rom;
+  if(id == ID::SPC7110PROM) memory = &spc7110.prom;
+  if(id == ID::SPC7110DROM) memory = &spc7110.drom;
+  if(id == ID::SDD1ROM) memory = &sdd1.rom;
+  if(id == ID::BsxROM) memory = &bsxcartridge.rom;
+  if(id == ID::SufamiTurboSlotAROM) memory = &sufamiturboA.rom;
+  if(id == ID::SufamiTurboSlotBROM) memory = &sufamiturboB.rom;
+
+  if(memory == nullptr || memory->size() == 0 || size < memory->size()) return false;
+  memory->share(data, memory->size());
+  return true;
+}
+
 void Interface::save(unsigned id, const stream& stream) {
   if(id == ID::RAM) stream.write(cartridge.ram.data(), cartridge.ram.size());
   if(id == ID::EventRAM) stream.write(event.ram.data(), event.ram.size());
@@ -99,6 +99,7 @@ struct Interface : Emulator::Interface {
   void load(unsigned id);
   void save();
   void load(unsigned id, const stream& stream);
+  bool share(unsigned id, const uint8* data, unsigned size);
   void save(unsigned id, const stream& stream);
   void unload();
 
@@ -127,7 +128,7 @@ struct Interface : Emulator::Interface {
   vector<Device> device;
 };
 
-extern Interface* interface;
+extern threadlocal Interface* interface;
 
 #ifndef SFC_HPP
 }
@@ -19,11 +19,12 @@ StaticRAM::~StaticRAM() { delete[] data_; }
 
 void MappedRAM::reset() {
   if(data_) {
-    delete[] data_;
+    if(!shared_) delete[] data_;
     data_ = nullptr;
   }
   size_ = 0;
   write_protect_ = false;
+  shared_ = false;
 }
 
 void MappedRAM::map(uint8* source, unsigned length) {
@@ -32,8 +33,19 @@ void MappedRAM::map(uint8* source, unsigned length) {
   size_ = data_ ? length : 0;
 }
 
+//maps memory owned by the caller (eg a ROM image mapped from its file) in place of a private copy:
+//it is never written nor freed, and must remain valid until reset()
+void MappedRAM::share(const uint8* source, unsigned length) {
+  reset();
+  data_ = (uint8*)source;
+  size_ = data_ ? length : 0;
+  write_protect_ = true;
+  shared_ = true;
+}
+
 void MappedRAM::copy(const stream& memory) {
-  if(data_) delete[] data_;
+  if(data_ && !shared_) delete[] data_;
+  shared_ = false;
   //round size up to multiple of 256-bytes
   size_ = (memory.size() & ~255) + ((bool)(memory.size() & 255) << 8);
   data_ = new uint8[size_]();
@@ -41,17 +53,18 @@ void MappedRAM::copy(const stream& memory) {
 }
 
 void MappedRAM::read(const stream& memory) {
+  if(shared_) return;
   memory.read(data_, min(memory.size(), size_));
 }
 
-void MappedRAM::write_protect(bool status) { write_protect_ = status; }
+void MappedRAM::write_protect(bool status) { write_protect_ = status || shared_; }
 uint8* MappedRAM::data() { return data_; }
 unsigned MappedRAM::size() const { return size_; }
 
 uint8 MappedRAM::read(unsigned addr) { return data_[addr]; }
 void MappedRAM::write(unsigned addr, uint8 n) { if(!write_protect_) data_[addr] = n; }
 const uint8& MappedRAM::operator[](unsigned addr) const { return data_[addr]; }
-MappedRAM::MappedRAM() : data_(nullptr), size_(0), write_protect_(false) {}
+MappedRAM::MappedRAM() : data_(nullptr), size_(0), write_protect_(false), shared_(false) {}
 
 //Bus
 
@@ -73,18 +86,25 @@ unsigned Bus::mirror(unsigned addr, unsigned size) {
   return base;
 }
 
+//removes the masked bits from addr, shifting the bits above each one down:
+//highest first, so that the positions of the lower masked bits are unaffected
 unsigned Bus::reduce(unsigned addr, unsigned mask) {
-  unsigned result = 0, length = 0;
-  for(unsigned n = 0; n < 24; n++) {
-    unsigned bit = 1 << n;
-    if(mask & bit) continue;
-    result |= (bool)(addr & bit) << length++;
+  addr &= 0xffffff;
+  mask &= 0xffffff;
+  while(mask) {
+    unsigned bit = 1u << (31 - __builtin_clz(mask));
+    addr = (addr & (bit - 1)) | (addr >> 1 & ~(bit - 1));
+    mask &= ~bit;
   }
-  return result;
+  return addr;
 }
 
 uint8 Bus::read(unsigned addr) {
-  uint8 data = reader[lookup[addr]](target[addr]);
+  const Page& p = page[addr >> 8];
+  uint8 data;
+  if(p.rdata) data = p.rdata[addr & 0xff];
+  else if(p.lookup) data = reader[p.lookup[addr & 0xff]](p.target[addr & 0xff]);
+  else data = reader[p.id](p.offset + (addr & 0xff));
 
   if(cheat.enable()) {
     if(auto result = cheat.find(addr, data)) return result();
@@ -94,5 +114,8 @@ uint8 Bus::read(unsigned addr) {
 }
 
 void Bus::write(unsigned addr, uint8 data) {
-  return writer[lookup[addr]](target[addr], data);
+  const Page& p = page[addr >> 8];
+  if(p.wdata) p.wdata[addr & 0xff] = data;
+  else if(p.lookup) writer[p.lookup[addr & 0xff]](p.target[addr & 0xff], data);
+  else writer[p.id](p.offset + (addr & 0xff), data);
 }
@@ -3,14 +3,15 @@
 #define MEMORY_CPP
 namespace SuperFamicom {
 
-Bus bus;
+threadlocal Bus bus;
 
 void Bus::map(
   const function<uint8 (unsigned)>& reader,
   const function<void (unsigned, uint8)>& writer,
   unsigned banklo, unsigned bankhi,
   unsigned addrlo, unsigned addrhi,
-  unsigned size, unsigned base, unsigned mask
+  unsigned size, unsigned base, unsigned mask,
+  uint8* data, bool writable
 ) {
   assert(banklo <= bankhi && banklo <= 0xff);
   assert(addrlo <= addrhi && addrlo <= 0xffff);
@@ -20,16 +21,69 @@ void Bus::map(
   this->reader[id] = reader;
   this->writer[id] = writer;
 
+  if(size == 0) data = nullptr;
+
+  //when the mask leaves the low byte alone and the mirrored range is a whole number of pages,
+  //every page maps linearly: only its first byte needs reducing and mirroring
+  bool paged = (mask & 0xff) == 0 && (size == 0 || (((size - base) & 0xff) == 0 && size != base));
+
+  uint32 offset[256];
   for(unsigned bank = banklo; bank <= bankhi; bank++) {
-    for(unsigned addr = addrlo; addr <= addrhi; addr++) {
-      unsigned offset = reduce(bank << 16 | addr, mask);
-      if(size) offset = base + mirror(offset, size - base);
-      lookup[bank << 16 | addr] = id;
-      target[bank << 16 | addr] = offset;
+    for(unsigned addr = addrlo & ~0xff; addr <= addrhi; addr += 0x100) {
+      Page& p = page[(bank << 16 | addr) >> 8];
+      unsigned lo = max(addrlo, addr) & 0xff;
+      unsigned hi = min(addrhi, addr | 0xff) & 0xff;
+
+      bool linear = true;
+      if(paged) {
+        unsigned first = reduce(bank << 16 | addr, mask);
+        if(size) first = base + mirror(first, size - base);
+        for(unsigned n = lo; n <= hi; n++) offset[n] = first + n;
+      } else {
+        for(unsigned n = lo; n <= hi; n++) {
+          offset[n] = reduce(bank << 16 | addr | n, mask);
+          if(size) offset[n] = base + mirror(offset[n], size - base);
+          if(offset[n] != offset[lo] + (n - lo)) linear = false;
+        }
+      }
+
+      if(lo == 0x00 && hi == 0xff && linear) {
+        if(p.lookup) {
+          delete[] p.lookup;
+          delete[] p.target;
+          p.lookup = nullptr;
+          p.target = nullptr;
+        }
+        p.id = id;
+        p.offset = offset[0];
+        p.rdata = data ? data + offset[0] : nullptr;
+        p.wdata = writable ? p.rdata : nullptr;
+        continue;
+      }
+
+      page_split(p);
+      for(unsigned n = lo; n <= hi; n++) {
+        p.lookup[n] = id;
+        p.target[n] = offset[n];
+      }
     }
   }
 }
 
+//convert a page owned by a single mapping into per-byte lookup tables,
+//so that part of it can be overridden by another mapping
+void Bus::page_split(Page& p) {
+  if(p.lookup) return;
+  p.lookup = new uint8[256];
+  p.target = new uint32[256];
+  for(unsigned n = 0; n < 256; n++) {
+    p.lookup[n] = p.id;
+    p.target[n] = p.offset + n;
+  }
+  p.rdata = nullptr;
+  p.wdata = nullptr;
+}
+
 void Bus::map_reset() {
   function<uint8 (unsigned)> reader = [](unsigned) { return cpu.regs.mdr; };
   function<void (unsigned, uint8)> writer = [](unsigned, uint8) {};
@@ -51,20 +105,23 @@ void Bus::map_xml() {
         unsigned bankhi = hex(bankpart(1, bankpart(0)));
         unsigned addrlo = hex(addrpart(0));
         unsigned addrhi = hex(addrpart(1, addrpart(0)));
-        map(m.reader, m.writer, banklo, bankhi, addrlo, addrhi, m.size, m.base, m.mask);
+        uint8* data = m.ram ? m.ram->data() : nullptr;
+        map(m.reader, m.writer, banklo, bankhi, addrlo, addrhi, m.size, m.base, m.mask, data);
       }
     }
   }
 }
 
 Bus::Bus() {
-  lookup = new uint8 [16 * 1024 * 1024];
-  target = new uint32[16 * 1024 * 1024];
+  page = new Page[64 * 1024]();
 }
 
 Bus::~Bus() {
-  delete[] lookup;
-  delete[] target;
+  for(unsigned n = 0; n < 64 * 1024; n++) {
+    delete[] page[n].lookup;
+    delete[] page[n].target;
+  }
+  delete[] page;
 }
 
 }
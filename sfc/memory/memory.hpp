@@ -24,6 +24,7 @@ private:
 struct MappedRAM : Memory {
   inline void reset();
   inline void map(uint8*, unsigned);
+  inline void share(const uint8*, unsigned);
   inline void copy(const stream& memory);
   inline void read(const stream& memory);
 
@@ -40,6 +41,7 @@ private:
   uint8* data_;
   unsigned size_;
   bool write_protect_;
+  bool shared_;  //data_ is borrowed, read-only memory
 };
 
 struct Bus {
@@ -49,8 +51,19 @@ struct Bus {
   alwaysinline uint8 read(unsigned addr);
   alwaysinline void write(unsigned addr, uint8 data);
 
-  uint8* lookup;
-  uint32* target;
+  //the 24-bit address space is split into 256-byte pages:
+  //pages backed by plain memory are accessed directly through rdata/wdata,
+  //pages owned by one handler store its ID and the offset of the first byte,
+  //and pages shared by several mappings fall back to per-byte lookup tables.
+  struct Page {
+    uint8* rdata;
+    uint8* wdata;
+    uint8* lookup;
+    uint32* target;
+    uint32 offset;
+    uint8 id;
+  };
+  Page* page;
 
   unsigned idcount;
   function<uint8 (unsigned)> reader[256];
@@ -61,7 +74,8 @@ struct Bus {
     const function<void (unsigned, uint8)>& writer,
     unsigned banklo, unsigned bankhi,
     unsigned addrlo, unsigned addrhi,
-    unsigned size = 0, unsigned base = 0, unsigned mask = 0
+    unsigned size = 0, unsigned base = 0, unsigned mask = 0,
+    uint8* data = nullptr, bool writable = false
   );
 
   void map_reset();
@@ -69,6 +83,9 @@ struct Bus {
 
   Bus();
   ~Bus();
+
+private:
+  void page_split(Page&);
 };
 
-extern Bus bus;
+extern threadlocal Bus bus;
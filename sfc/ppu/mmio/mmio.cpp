@@ -833,8 +833,29 @@ uint8 PPU::mmio_read(unsigned addr) {
 }
 
 void PPU::mmio_write(unsigned addr, uint8 data) {
+  if(configuration.ppu_catchup && clock < 0 && writes.size < Writes::Size) {
+    writes.time[writes.size] = time - clock;
+    writes.addr[writes.size] = addr;
+    writes.data[writes.size] = data;
+    writes.size++;
+    return;
+  }
+
   cpu.synchronize_ppu();
+  mmio_apply(addr, data);
+}
+
+//applies the queued writes the PPU has now reached; the queue empties
+//whenever the PPU catches up with the CPU
+void PPU::mmio_replay() {
+  while(writes.read != writes.size && writes.time[writes.read] <= time) {
+    mmio_apply(writes.addr[writes.read], writes.data[writes.read]);
+    writes.read++;
+  }
+  if(writes.read == writes.size) writes.read = writes.size = 0;
+}
 
+void PPU::mmio_apply(unsigned addr, uint8 data) {
   switch(addr & 0xffff) {
   case 0x2100: return mmio_w2100(data);  //INIDISP
   case 0x2101: return mmio_w2101(data);  //OBSEL
@@ -3,6 +3,18 @@ public:
   void mmio_write(unsigned addr, uint8 data);
 
 privileged:
+//with configuration.ppu_catchup, writes made while the PPU is behind the CPU are queued with
+//the PPU time they happened at, and applied by add_clocks() as the PPU reaches that time:
+//exactly where it would have stopped had the CPU synchronized to it for each one
+struct Writes {
+  enum : unsigned { Size = 256 };
+  uint64 time[Size];
+  uint16 addr[Size];
+  uint8 data[Size];
+  unsigned read;
+  unsigned size;
+} writes;
+
 struct {
   uint8 ppu1_mdr;
   uint8 ppu2_mdr;
@@ -162,4 +174,6 @@ uint8 mmio_r213d();  //OPVCT
 uint8 mmio_r213e();  //STAT77
 uint8 mmio_r213f();  //STAT78
 
+void mmio_apply(unsigned addr, uint8 data);
+void mmio_replay();
 void mmio_reset();
@@ -3,7 +3,7 @@
 #define PPU_CPP
 namespace SuperFamicom {
 
-PPU ppu;
+threadlocal PPU ppu;
 
 #include "background/background.cpp"
 #include "mmio/mmio.cpp"
@@ -14,6 +14,7 @@ PPU ppu;
 
 void PPU::step(unsigned clocks) {
   clock += clocks;
+  time += clocks;
 }
 
 void PPU::synchronize_cpu() {
@@ -74,6 +75,7 @@ void PPU::add_clocks(unsigned clocks) {
   while(clocks--) {
     tick(2);
     step(2);
+    if(writes.read != writes.size && writes.time[writes.read] <= time) mmio_replay();
     synchronize_cpu();
   }
 }
@@ -95,6 +97,8 @@ void PPU::power() {
 void PPU::reset() {
   create(Enter, system.cpu_frequency());
   PPUcounter::reset();
+  time = 0;
+  writes.read = writes.size = 0;
   memset(surface, 0, 512 * 512 * sizeof(uint32));
 
   mmio_reset();
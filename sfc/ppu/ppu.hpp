@@ -27,6 +27,7 @@ privileged:
 
   uint32* surface;
   uint32* output;
+  uint64 time;  //clocks run since reset
 
   struct {
     bool interlace;
@@ -69,4 +70,4 @@ privileged:
   } debugger;
 };
 
-extern PPU ppu;
+extern threadlocal PPU ppu;
@@ -16,6 +16,13 @@ void PPU::serialize(serializer& s) {
   Thread::serialize(s);
   PPUcounter::serialize(s);
 
+  s.integer(time);
+  s.array(writes.time);
+  s.array(writes.addr);
+  s.array(writes.data);
+  s.integer(writes.read);
+  s.integer(writes.size);
+
   s.array(vram);
   s.array(oam);
   s.array(cgram);
@@ -14,4 +14,4 @@ struct Scheduler : property<Scheduler> {
   Scheduler();
 };
 
-extern Scheduler scheduler;
+extern threadlocal Scheduler scheduler;
@@ -12,7 +12,10 @@
 namespace SuperFamicom {
   namespace Info {
     static const char Name[] = "bsnes";
-    static const unsigned SerializerVersion = 27;
+    //version of the state container (header and section layout), not of its contents:
+    //a component's format change bumps that component's section version in serialize_init()
+    static const unsigned SerializerVersion = 29;
+    static const unsigned SerializerSectioned = 29;  //oldest container unserialize() reads
   }
 }
 
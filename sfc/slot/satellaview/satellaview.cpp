@@ -3,7 +3,7 @@
 #define SATELLAVIEW_CARTRIDGE_CPP
 namespace SuperFamicom {
 
-SatellaviewCartridge satellaviewcartridge;
+threadlocal SatellaviewCartridge satellaviewcartridge;
 
 void SatellaviewCartridge::init() {
 }
@@ -24,4 +24,4 @@ private:
   } regs;
 };
 
-extern SatellaviewCartridge satellaviewcartridge;
+extern threadlocal SatellaviewCartridge satellaviewcartridge;
@@ -4,8 +4,8 @@
 namespace SuperFamicom {
 
 #include "serialization.cpp"
-SufamiTurboCartridge sufamiturboA;
-SufamiTurboCartridge sufamiturboB;
+threadlocal SufamiTurboCartridge sufamiturboA;
+threadlocal SufamiTurboCartridge sufamiturboB;
 
 void SufamiTurboCartridge::load() {
 }
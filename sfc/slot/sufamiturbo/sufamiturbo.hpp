@@ -7,5 +7,5 @@ struct SufamiTurboCartridge {
   void serialize(serializer&);
 };
 
-extern SufamiTurboCartridge sufamiturboA;
-extern SufamiTurboCartridge sufamiturboB;
+extern threadlocal SufamiTurboCartridge sufamiturboA;
+extern threadlocal SufamiTurboCartridge sufamiturboB;
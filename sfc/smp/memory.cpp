@@ -55,16 +55,19 @@ uint8 SMP::op_busread(uint16 addr) {
     return 0x00;
 
   case 0xfd:  //T0OUT -- 4-bit counter value
+    synchronize_timers();
     result = timer0.stage3_ticks;
     timer0.stage3_ticks = 0;
     return result;
 
   case 0xfe:  //T1OUT -- 4-bit counter value
+    synchronize_timers();
     result = timer1.stage3_ticks;
     timer1.stage3_ticks = 0;
     return result;
 
   case 0xff:  //T2OUT -- 4-bit counter value
+    synchronize_timers();
     result = timer2.stage3_ticks;
     timer2.stage3_ticks = 0;
     return result;
@@ -78,6 +81,7 @@ void SMP::op_buswrite(uint16 addr, uint8 data) {
   case 0xf0:  //TEST
     if(regs.p.p) break;  //writes only valid when P flag is clear
 
+    synchronize_timers();
     status.clock_speed    = (data >> 6) & 3;
     status.timer_speed    = (data >> 4) & 3;
     status.timers_enable  = data & 0x08;
@@ -94,6 +98,7 @@ void SMP::op_buswrite(uint16 addr, uint8 data) {
 
   case 0xf1:  //CONTROL
     status.iplrom_enable = data & 0x80;
+    synchronize_timers();
 
     if(data & 0x30) {
       //one-time clearing of APU port read registers,
@@ -155,14 +160,17 @@ void SMP::op_buswrite(uint16 addr, uint8 data) {
     break;
 
   case 0xfa:  //T0TARGET
+    synchronize_timers();
     timer0.target = data;
     break;
 
   case 0xfb:  //T1TARGET
+    synchronize_timers();
     timer1.target = data;
     break;
 
   case 0xfc:  //T2TARGET
+    synchronize_timers();
     timer2.target = data;
     break;
 
@@ -184,6 +192,7 @@ uint8 SMP::op_read(uint16 addr) {
   debugger.op_read(addr);
 
   add_clocks(12);
+  if(DSP::Threaded == false) synchronize_dsp();
   uint8 r = op_busread(addr);
   add_clocks(12);
   cycle_edge();
@@ -194,6 +203,7 @@ void SMP::op_write(uint16 addr, uint8 data) {
   debugger.op_write(addr, data);
 
   add_clocks(24);
+  if(DSP::Threaded == false) synchronize_dsp();
   op_buswrite(addr, data);
   cycle_edge();
 }
@@ -1,6 +1,7 @@
 #ifdef SMP_CPP
 
 void SMP::serialize(serializer& s) {
+  synchronize_timers();
   SPC700::serialize(s);
   Thread::serialize(s);
 
@@ -3,7 +3,7 @@
 #define SMP_CPP
 namespace SuperFamicom {
 
-SMP smp;
+threadlocal SMP smp;
 
 #include "memory.cpp"
 #include "timing.cpp"
@@ -15,6 +15,7 @@ void SMP::step(unsigned clocks) {
 }
 
 void SMP::synchronize_cpu() {
+  if(DSP::Threaded == false) synchronize_dsp();
   if(CPU::Threaded == true) {
     if(clock >= 0 && scheduler.sync != Scheduler::SynchronizeMode::All) co_switch(cpu.thread);
   } else {
@@ -35,6 +36,7 @@ void SMP::Enter() { smp.enter(); }
 void SMP::enter() {
   while(true) {
     if(scheduler.sync == Scheduler::SynchronizeMode::All) {
+      if(DSP::Threaded == false) synchronize_dsp();
       scheduler.exit(Scheduler::ExitReason::SynchronizeEvent);
     }
 
@@ -69,6 +71,7 @@ void SMP::reset() {
   status.clock_counter = 0;
   status.dsp_counter = 0;
   status.timer_step = 3;
+  status.timer_cycles = 0;
 
   //$00f0
   status.clock_speed = 0;
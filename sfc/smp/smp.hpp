@@ -24,6 +24,7 @@ privileged:
     unsigned clock_counter;
     unsigned dsp_counter;
     unsigned timer_step;
+    uint64 timer_cycles;  //cycle edges not yet applied to the timers
 
     //$00f0
     uint8 clock_speed;
@@ -78,7 +79,7 @@ privileged:
     bool enable;
     uint8 target;
 
-    void tick();
+    void tick(uint64 cycles);
     void synchronize_stage1();
   };
 
@@ -88,6 +89,7 @@ privileged:
 
   alwaysinline void add_clocks(unsigned clocks);
   alwaysinline void cycle_edge();
+  void synchronize_timers();
 };
 
-extern SMP smp;
+extern threadlocal SMP smp;
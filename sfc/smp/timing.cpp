@@ -2,7 +2,9 @@
 
 void SMP::add_clocks(unsigned clocks) {
   step(clocks);
-  synchronize_dsp();
+  //the S-DSP interacts with the S-SMP only through APU RAM and $f2/$f3,
+  //so it is caught up lazily: before each bus access, and before yielding to the S-CPU
+  if(DSP::Threaded == true) synchronize_dsp();
 
   #if defined(DEBUGGER)
   synchronize_cpu();
@@ -14,9 +16,9 @@ void SMP::add_clocks(unsigned clocks) {
 }
 
 void SMP::cycle_edge() {
-  timer0.tick();
-  timer1.tick();
-  timer2.tick();
+  //the timers are only observable through $f0-$f1 and $fa-$ff,
+  //so elapsed cycles are counted here and applied upon access
+  status.timer_cycles++;
 
   //TEST register S-SMP speed control
   //24 clocks have already been added for this cycle at this point
@@ -28,16 +30,52 @@ void SMP::cycle_edge() {
   }
 }
 
+void SMP::synchronize_timers() {
+  if(status.timer_cycles == 0) return;
+  timer0.tick(status.timer_cycles);
+  timer1.tick(status.timer_cycles);
+  timer2.tick(status.timer_cycles);
+  status.timer_cycles = 0;
+}
+
+//same result as ticking the timer once per cycle edge, in constant time
 template<unsigned timer_frequency>
-void SMP::Timer<timer_frequency>::tick() {
+void SMP::Timer<timer_frequency>::tick(uint64 cycles) {
   //stage 0 increment
-  stage0_ticks += smp.status.timer_step;
-  if(stage0_ticks < timer_frequency) return;
-  stage0_ticks -= timer_frequency;
+  uint64 ticks = stage0_ticks + cycles * smp.status.timer_step;
+  uint64 toggles = ticks / timer_frequency;
+  stage0_ticks = ticks % timer_frequency;
+  if(toggles == 0) return;
 
   //stage 1 increment
+  //the first toggle also brings current_line in step with stage 1
   stage1_ticks ^= 1;
   synchronize_stage1();
+  if(--toggles == 0) return;
+
+  if(smp.status.timers_enable == false || smp.status.timers_disable == true) {
+    stage1_ticks ^= toggles & 1;  //line held low: no pulses
+    return;
+  }
+
+  //the line follows stage 1, pulsing on every other toggle
+  uint64 pulses = (toggles + stage1_ticks) / 2;
+  stage1_ticks ^= toggles & 1;
+  current_line = stage1_ticks;
+
+  //stage 2 increment
+  if(enable == false) return;
+  unsigned distance = (uint8)(target - stage2_ticks - 1) + 1;  //pulses until stage2_ticks == target
+  if(pulses < distance) {
+    stage2_ticks += pulses;
+    return;
+  }
+
+  //stage 3 increment
+  unsigned period = target ? (unsigned)target : 256;
+  pulses -= distance;
+  stage3_ticks += (1 + pulses / period) & 15;
+  stage2_ticks = pulses % period;
 }
 
 template<unsigned timer_frequency>
@@ -1,69 +1,95 @@
 #ifdef SYSTEM_CPP
 
-Audio audio;
+threadlocal Audio audio;
 
 void Audio::coprocessor_enable(bool state) {
+  if(suspended) return;
   coprocessor = state;
   dspaudio.clear();
 
-  dsp_rdoffset = cop_rdoffset = 0;
-  dsp_wroffset = cop_wroffset = 0;
   dsp_length = cop_length = 0;
+  cop_input_length = 0;
 }
 
 void Audio::coprocessor_frequency(double input_frequency) {
+  if(suspended) return;
   dspaudio.setFrequency(input_frequency);
-  dspaudio.setResampler(nall::DSP::ResampleEngine::Sinc);
+  dspaudio.setResampler(nall::DSP::ResampleEngine::Polyphase);
   dspaudio.setResamplerFrequency(system.apu_frequency() / 768.0);
 }
 
 void Audio::sample(int16 lsample, int16 rsample) {
-  if(coprocessor == false) return interface->audioSample(lsample, rsample);
+  if(suspended) return;
+  if(dsp_length == buffer_size) flush();
+  if(dsp_length == buffer_size) dsp_length = 0;  //coprocessor stalled: drop rather than block
 
-  dsp_buffer[dsp_wroffset] = ((uint16)lsample << 0) + ((uint16)rsample << 16);
-  dsp_wroffset = (dsp_wroffset + 1) & buffer_mask;
-  dsp_length = (dsp_length + 1) & buffer_mask;
-  flush();
+  dsp_buffer[dsp_length * 2 + 0] = lsample;
+  dsp_buffer[dsp_length * 2 + 1] = rsample;
+  dsp_length++;
 }
 
 void Audio::coprocessor_sample(int16 lsample, int16 rsample) {
-  signed samples[] = {lsample, rsample};
-  dspaudio.sample(samples);
+  if(suspended) return;
+  cop_input[cop_input_length * 2 + 0] = lsample;
+  cop_input[cop_input_length * 2 + 1] = rsample;
+  if(++cop_input_length == input_size) resample();
+}
+
+void Audio::resample() {
+  dspaudio.sample(cop_input, cop_input_length);
+  cop_input_length = 0;
+
+  signed samples[2];
   while(dspaudio.pending()) {
     dspaudio.read(samples);
 
-    cop_buffer[cop_wroffset] = ((uint16)samples[0] << 0) + ((uint16)samples[1] << 16);
-    cop_wroffset = (cop_wroffset + 1) & buffer_mask;
-    cop_length = (cop_length + 1) & buffer_mask;
-    flush();
+    if(cop_length == buffer_size) flush();
+    if(cop_length == buffer_size) cop_length = 0;
+
+    cop_buffer[cop_length * 2 + 0] = samples[0];
+    cop_buffer[cop_length * 2 + 1] = samples[1];
+    cop_length++;
   }
 }
 
-void Audio::init() {
+//called once per frame: hands every sample produced so far to the interface in one batch
+void Audio::update() {
+  if(suspended) return;
+  flush();
 }
 
-void Audio::flush() {
-  while(dsp_length > 0 && cop_length > 0) {
-    uint32 dsp_sample = dsp_buffer[dsp_rdoffset];
-    uint32 cop_sample = cop_buffer[cop_rdoffset];
-
-    dsp_rdoffset = (dsp_rdoffset + 1) & buffer_mask;
-    cop_rdoffset = (cop_rdoffset + 1) & buffer_mask;
+void Audio::init() {
+  dsp_length = cop_length = 0;
+  cop_input_length = 0;
+  suspended = false;
+}
 
-    dsp_length--;
-    cop_length--;
+void Audio::suspend(bool state) {
+  suspended = state;
+}
 
-    signed dsp_left  = (int16)(dsp_sample >>  0);
-    signed dsp_right = (int16)(dsp_sample >> 16);
+void Audio::flush() {
+  if(coprocessor == false) {
+    if(dsp_length) interface->audioSamples(dsp_buffer, dsp_length);
+    dsp_length = 0;
+    return;
+  }
 
-    signed cop_left  = (int16)(cop_sample >>  0);
-    signed cop_right = (int16)(cop_sample >> 16);
+  if(cop_input_length) resample();
+  unsigned length = min(dsp_length, cop_length);
+  if(length == 0) return;
 
-    interface->audioSample(
-      sclamp<16>((dsp_left  + cop_left ) / 2),
-      sclamp<16>((dsp_right + cop_right) / 2)
-    );
+  //the average of two int16 samples cannot overflow, so no clamping is needed
+  for(unsigned n = 0; n < length * 2; n++) {
+    dsp_buffer[n] = (dsp_buffer[n] + cop_buffer[n]) / 2;
   }
+  interface->audioSamples(dsp_buffer, length);
+
+  //keep whichever stream ran ahead for the next frame
+  dsp_length -= length;
+  cop_length -= length;
+  memmove(dsp_buffer, dsp_buffer + length * 2, dsp_length * 2 * sizeof(int16));
+  memmove(cop_buffer, cop_buffer + length * 2, cop_length * 2 * sizeof(int16));
 }
 
 #endif
@@ -3,18 +3,29 @@ struct Audio {
   void coprocessor_frequency(double frequency);
   void sample(int16 lsample, int16 rsample);
   void coprocessor_sample(int16 lsample, int16 rsample);
+  void update();
   void init();
+  //while suspended, samples are dropped before they reach any buffer or the resampler, and the
+  //chips' power-on reconfiguration (as from loading a state) is ignored: frames emulated and
+  //then rewound (run-ahead) leave the pending samples and the resampler history untouched
+  void suspend(bool state);
 
 private:
   nall::DSP dspaudio;
   bool coprocessor;
-  enum : unsigned { buffer_size = 256, buffer_mask = buffer_size - 1 };
-  uint32 dsp_buffer[buffer_size], cop_buffer[buffer_size];
-  unsigned dsp_rdoffset, cop_rdoffset;
-  unsigned dsp_wroffset, cop_wroffset;
+  bool suspended = false;
+  //stereo frames; one video frame is ~534 (NTSC) or ~640 (PAL) of them
+  enum : unsigned { buffer_size = 2048 };
+  int16 dsp_buffer[buffer_size * 2], cop_buffer[buffer_size * 2];
   unsigned dsp_length, cop_length;
+  //coprocessor samples awaiting resampling, handed to dspaudio a block at a time
+  enum : unsigned { input_size = 512 };
+  signed cop_input[input_size * 2];
+  unsigned cop_input_length;
+
+  void resample();
 
   void flush();
 };
 
-extern Audio audio;
+extern threadlocal Audio audio;
@@ -0,0 +1,180 @@
+#ifdef SYSTEM_CPP
+
+threadlocal History history;
+
+//delta format: { varint skip, varint length, uint8 xor[length] }*
+//XOR makes a delta symmetric: applying it to either state yields the other.
+//unchanged spans are found a block at a time, so mostly-idle memory
+//(cartridge RAM, VRAM) costs a memcmp rather than a byte loop.
+
+void History::reset(unsigned capacity) {
+  if(state) delete[] state;
+  if(buffer) delete[] buffer;
+  state = nullptr;
+  state_size = 0;
+  state_valid = false;
+  buffer = capacity ? new uint8[capacity] : nullptr;
+  this->capacity = capacity;
+  clear();
+}
+
+bool History::push() {
+  if(capacity == 0) return false;
+  system.runtosave();
+  serializer s = system.serialize();
+
+  if(state_valid == false || state_size != s.size()) {
+    if(state) delete[] state;
+    state_size = s.size();
+    state = new uint8[state_size];
+    memcpy(state, s.data(), state_size);
+    state_valid = true;
+    clear();
+    return true;
+  }
+
+  encode(s.data(), state, state_size);
+  store(delta.data(), delta.size());
+  memcpy(state, s.data(), state_size);
+  return true;
+}
+
+bool History::pop() {
+  if(state_valid == false) return false;
+  serializer s = serializer::view(state, state_size);
+  if(system.unserialize(s) == false) return false;
+
+  if(count == 0) {
+    state_valid = false;
+    return true;
+  }
+
+  unsigned length = header((head + capacity - 4) % capacity);
+  unsigned offset = (head + capacity - 4 - length) % capacity;
+  delta.resize(length);
+  load(offset, delta.data(), length);
+  decode(state, delta.data(), length);
+
+  head = (offset + capacity - 4) % capacity;
+  used -= length + 8;
+  count--;
+  return true;
+}
+
+unsigned History::size() const {
+  return state_valid ? count + 1 : 0;
+}
+
+void History::encode(const uint8* source, const uint8* target, unsigned size) {
+  enum : unsigned { Block = 64, Gap = 8 };
+  delta.reset();
+
+  auto varint = [&](unsigned data) {
+    while(data >= 0x80) {
+      delta.append(0x80 | (data & 0x7f));
+      data >>= 7;
+    }
+    delta.append(data);
+  };
+
+  unsigned offset = 0;
+  while(offset < size) {
+    unsigned first = offset;
+    while(first + Block <= size && !memcmp(source + first, target + first, Block)) first += Block;
+    while(first < size && source[first] == target[first]) first++;
+    if(first == size) break;
+
+    //extend the span across short unchanged gaps; a new record costs two varints
+    unsigned last = first, n = first + 1;
+    while(n < size && n - last <= Gap) {
+      if(source[n] != target[n]) last = n;
+      n++;
+    }
+
+    varint(first - offset);
+    varint(last + 1 - first);
+    for(unsigned n = first; n <= last; n++) delta.append(source[n] ^ target[n]);
+    offset = last + 1;
+  }
+}
+
+void History::decode(uint8* target, const uint8* data, unsigned length) {
+  auto varint = [&]() -> unsigned {
+    unsigned result = 0, shift = 0;
+    while(true) {
+      uint8 byte = *data++;
+      length--;
+      result |= (byte & 0x7f) << shift;
+      if((byte & 0x80) == 0) return result;
+      shift += 7;
+    }
+  };
+
+  unsigned offset = 0;
+  while(length) {
+    offset += varint();
+    unsigned size = varint();
+    for(unsigned n = 0; n < size; n++) target[offset++] ^= data[n];
+    data += size;
+    length -= size;
+  }
+}
+
+//each entry is framed as { uint32 length, uint8 data[length], uint32 length }
+//so it can be walked from either end of the ring
+
+void History::store(const uint8* data, unsigned length) {
+  if(length + 8 > capacity) return clear();
+  while(capacity - used < length + 8) {
+    unsigned size = 4 + header(tail) + 4;
+    tail = (tail + size) % capacity;
+    used -= size;
+    count--;
+  }
+
+  uint8 frame[4] = { uint8(length >> 0), uint8(length >> 8), uint8(length >> 16), uint8(length >> 24) };
+  write(frame, 4);
+  write(data, length);
+  write(frame, 4);
+  used += length + 8;
+  count++;
+}
+
+void History::write(const uint8* data, unsigned length) {
+  unsigned first = min(length, capacity - head);
+  memcpy(buffer + head, data, first);
+  memcpy(buffer, data + first, length - first);
+  head = (head + length) % capacity;
+}
+
+void History::load(unsigned offset, uint8* data, unsigned length) const {
+  unsigned first = min(length, capacity - offset);
+  memcpy(data, buffer + offset, first);
+  memcpy(data + first, buffer, length - first);
+}
+
+unsigned History::header(unsigned offset) const {
+  uint8 data[4];
+  load(offset, data, 4);
+  return data[0] << 0 | data[1] << 8 | data[2] << 16 | data[3] << 24;
+}
+
+void History::clear() {
+  head = 0;
+  tail = 0;
+  used = 0;
+  count = 0;
+}
+
+History::History() {
+  state = nullptr;
+  buffer = nullptr;
+  reset(0);
+}
+
+History::~History() {
+  if(state) delete[] state;
+  if(buffer) delete[] buffer;
+}
+
+#endif
@@ -0,0 +1,38 @@
+//rewind history
+//the newest state is kept whole; each older state is stored as a delta against
+//the state after it, in a fixed-size ring buffer that discards the oldest first
+
+struct History {
+  void reset(unsigned capacity);
+  bool push();
+  bool pop();
+  unsigned size() const;
+
+  History();
+  ~History();
+
+private:
+  uint8* state;
+  unsigned state_size;
+  bool state_valid;
+
+  uint8* buffer;
+  unsigned capacity;
+  unsigned head;
+  unsigned tail;
+  unsigned used;
+  unsigned count;
+
+  vector<uint8> delta;
+
+  void encode(const uint8* source, const uint8* target, unsigned size);
+  void decode(uint8* target, const uint8* data, unsigned length);
+
+  void store(const uint8* data, unsigned length);
+  void write(const uint8* data, unsigned length);
+  void load(unsigned offset, uint8* data, unsigned length) const;
+  unsigned header(unsigned offset) const;
+  void clear();
+};
+
+extern threadlocal History history;
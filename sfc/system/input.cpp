@@ -1,6 +1,6 @@
 #ifdef SYSTEM_CPP
 
-Input input;
+threadlocal Input input;
 
 void Input::connect(bool port, Input::Device id) {
   Controller*& controller = (port == Controller::Port1 ? port1 : port2);
@@ -36,4 +36,4 @@ struct Input {
   ~Input();
 };
 
-extern Input input;
+extern threadlocal Input input;
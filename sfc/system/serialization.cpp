@@ -1,6 +1,14 @@
 #ifdef SYSTEM_CPP
 
-serializer System::serialize() {
+//a state is a header followed by one section per component with state in this cartridge:
+//  { uint32 tag; uint32 version; uint32 size; uint32 stored; uint8 data[stored]; }
+//size is the section's serialized size; stored < size means data is LZ4 compressed.
+//sections are found by tag and checked against their own version on load, so changing
+//one component's format only invalidates states that contain that component, and the header
+//version (the container's) accepts states from every build since sections were introduced.
+//unknown sections are skipped.
+
+serializer System::serialize(bool compress) {
   serializer s(serialize_size);
 
   unsigned signature = 0x31545342, version = Info::SerializerVersion;
@@ -16,12 +24,40 @@ serializer System::serialize() {
   s.array(description);
   s.array(profile);
 
-  serialize_all(s);
+  unsigned count = sections.size();
+  s.integer(count);
+
+  vector<uint8> packed;
+  for(auto& section : sections) {
+    unsigned tag = section.tag, version = section.version, size = section.size, stored = size;
+    s.integer(tag);
+    s.integer(version);
+    s.integer(size);
+
+    if(compress == false) {
+      s.integer(stored);
+      section.serialize(s);
+      continue;
+    }
+
+    serializer raw(size);
+    section.serialize(raw);
+    packed.resize(lz4_bound(size));
+    unsigned length = lz4_compress(packed.data(), raw.data(), size);
+    if(length < size) {
+      s.integer(stored = length);
+      s.array(packed.data(), length);
+    } else {
+      s.integer(stored);
+      s.array((uint8*)raw.data(), size);
+    }
+  }
+
   return s;
 }
 
 bool System::unserialize(serializer& s) {
-  unsigned signature, version;
+  unsigned signature, version, count;
   char hash[64], description[512], profile[16];
 
   s.integer(signature);
@@ -29,13 +65,52 @@ bool System::unserialize(serializer& s) {
   s.array(hash);
   s.array(description);
   s.array(profile);
+  s.integer(count);
 
   if(signature != 0x31545342) return false;
-  if(version != Info::SerializerVersion) return false;
+  if(version < Info::SerializerSectioned || version > Info::SerializerVersion) return false;
   if(strcmp(profile, Emulator::Profile)) return false;
 
+  //every section is located (and expanded) before any state changes,
+  //so a state that does not fit this cartridge leaves the system untouched
+  vector<const uint8*> found;
+  found.resize(sections.size());
+  vector<vector<uint8>> expanded;
+  expanded.resize(sections.size());
+
+  const uint8* data = s.data() + s.size();
+  const uint8* end = s.data() + s.capacity();
+  while(count--) {
+    if(end - data < 16) return false;
+    unsigned tag, version, size, stored;
+    serializer header = serializer::view(data, 16);
+    header.integer(tag);
+    header.integer(version);
+    header.integer(size);
+    header.integer(stored);
+    data += 16;
+    if(stored > end - data) return false;
+
+    for(unsigned n = 0; n < sections.size(); n++) {
+      if(sections[n].tag != tag) continue;
+      if(sections[n].version != version || sections[n].size != size || stored > size) return false;
+      found[n] = data;
+      if(stored < size) {
+        expanded[n].resize(size);
+        if(lz4_decompress(expanded[n].data(), size, data, stored) == false) return false;
+        found[n] = expanded[n].data();
+      }
+    }
+    data += stored;
+  }
+
+  for(auto section : found) if(section == nullptr) return false;
+
   power();
-  serialize_all(s);
+  for(unsigned n = 0; n < sections.size(); n++) {
+    serializer section = serializer::view(found[n], sections[n].size);
+    sections[n].serialize(section);
+  }
   return true;
 }
 
@@ -48,50 +123,61 @@ void System::serialize(serializer& s) {
   s.integer((unsigned&)expansion);
 }
 
-void System::serialize_all(serializer& s) {
-  cartridge.serialize(s);
-  system.serialize(s);
-  random.serialize(s);
-  cpu.serialize(s);
-  smp.serialize(s);
-  ppu.serialize(s);
-  dsp.serialize(s);
-
-  if(cartridge.has_gb_slot()) icd2.serialize(s);
-  if(cartridge.has_bs_cart()) bsxcartridge.serialize(s);
-  if(cartridge.has_event()) event.serialize(s);
-  if(cartridge.has_sa1()) sa1.serialize(s);
-  if(cartridge.has_superfx()) superfx.serialize(s);
-  if(cartridge.has_armdsp()) armdsp.serialize(s);
-  if(cartridge.has_hitachidsp()) hitachidsp.serialize(s);
-  if(cartridge.has_necdsp()) necdsp.serialize(s);
-  if(cartridge.has_epsonrtc()) epsonrtc.serialize(s);
-  if(cartridge.has_sharprtc()) sharprtc.serialize(s);
-  if(cartridge.has_spc7110()) spc7110.serialize(s);
-  if(cartridge.has_sdd1()) sdd1.serialize(s);
-  if(cartridge.has_obc1()) obc1.serialize(s);
-  if(cartridge.has_hsu1()) hsu1.serialize(s);
-  if(cartridge.has_msu1()) msu1.serialize(s);
-  if(cartridge.has_st_slots()) sufamiturboA.serialize(s), sufamiturboB.serialize(s);
-}
-
-//perform dry-run state save:
+//lists the sections of the loaded cartridge, and their sizes:
 //determines exactly how many bytes are needed to save state for this cartridge,
 //as amount varies per game (eg different RAM sizes, special chips, etc.)
 void System::serialize_init() {
   serializer s;
 
-  unsigned signature = 0, version = 0;
-  char hash[64], profile[16], description[512];
+  unsigned signature = 0, version = 0, count = 0;
+  char hash[64], description[512], profile[16];
 
   s.integer(signature);
   s.integer(version);
   s.array(hash);
-  s.array(profile);
   s.array(description);
-
-  serialize_all(s);
-  serialize_size = s.size();
+  s.array(profile);
+  s.integer(count);
+
+  sections.reset();
+  auto section = [&](const char* name, unsigned version, const function<void (serializer&)>& serialize) {
+    serializer size;
+    serialize(size);
+    uint32 tag = name[0] << 0 | name[1] << 8 | name[2] << 16 | name[3] << 24;
+    sections.append({tag, version, size.size(), serialize});
+  };
+
+  section("cart", 1, [](serializer& s) { cartridge.serialize(s); });
+  section("sys ", 1, [](serializer& s) { system.serialize(s); });
+  section("rand", 1, [](serializer& s) { random.serialize(s); });
+  section("cpu ", 1, [](serializer& s) { cpu.serialize(s); });
+  section("smp ", 1, [](serializer& s) { smp.serialize(s); });
+  section("ppu ", 2, [](serializer& s) { ppu.serialize(s); });
+  section("dsp ", 1, [](serializer& s) { dsp.serialize(s); });
+
+  if(cartridge.has_gb_slot()) section("icd2", 1, [](serializer& s) { icd2.serialize(s); });
+  if(cartridge.has_bs_cart()) section("bsx ", 1, [](serializer& s) { bsxcartridge.serialize(s); });
+  if(cartridge.has_event()) section("evnt", 1, [](serializer& s) { event.serialize(s); });
+  if(cartridge.has_sa1()) section("sa1 ", 1, [](serializer& s) { sa1.serialize(s); });
+  if(cartridge.has_superfx()) section("gsu ", 1, [](serializer& s) { superfx.serialize(s); });
+  if(cartridge.has_armdsp()) section("arm ", 1, [](serializer& s) { armdsp.serialize(s); });
+  if(cartridge.has_hitachidsp()) section("hg51", 1, [](serializer& s) { hitachidsp.serialize(s); });
+  if(cartridge.has_necdsp()) section("upd ", 1, [](serializer& s) { necdsp.serialize(s); });
+  if(cartridge.has_epsonrtc()) section("ertc", 1, [](serializer& s) { epsonrtc.serialize(s); });
+  if(cartridge.has_sharprtc()) section("srtc", 1, [](serializer& s) { sharprtc.serialize(s); });
+  if(cartridge.has_spc7110()) section("7110", 1, [](serializer& s) { spc7110.serialize(s); });
+  if(cartridge.has_sdd1()) section("sdd1", 1, [](serializer& s) { sdd1.serialize(s); });
+  if(cartridge.has_obc1()) section("obc1", 1, [](serializer& s) { obc1.serialize(s); });
+  if(cartridge.has_hsu1()) section("hsu1", 1, [](serializer& s) { hsu1.serialize(s); });
+  if(cartridge.has_msu1()) section("msu1", 1, [](serializer& s) { msu1.serialize(s); });
+  if(cartridge.has_st_slots()) {
+    section("stA ", 1, [](serializer& s) { sufamiturboA.serialize(s); });
+    section("stB ", 1, [](serializer& s) { sufamiturboB.serialize(s); });
+  }
+
+  unsigned size = s.size();
+  for(auto& section : sections) size += 16 + section.size;
+  serialize_size = size;
 }
 
 #endif
@@ -1,29 +1,39 @@
 #include <sfc/sfc.hpp>
+#if defined(THREAD_INSTANCES)
+  #include <mutex>
+#endif
 
 #define SYSTEM_CPP
 namespace SuperFamicom {
 
-System system;
-Configuration configuration;
-Random random;
+threadlocal System system;
+threadlocal Configuration configuration;
+threadlocal Random random;
 
 #include "video.cpp"
 #include "audio.cpp"
 #include "input.cpp"
+#include "history.cpp"
 #include "serialization.cpp"
 
 #include <sfc/scheduler/scheduler.cpp>
 
 void System::run() {
   scheduler.sync = Scheduler::SynchronizeMode::None;
+  synchronized = false;
 
   scheduler.enter();
   if(scheduler.exit_reason() == Scheduler::ExitReason::FrameEvent) {
     video.update();
+    audio.update();
+    //bring every thread to its entry point now, so that saving after this frame is free
+    if(configuration.snapshot) runtosave();
   }
 }
 
 void System::runtosave() {
+  if(synchronized) return;
+
   if(CPU::Threaded == true) {
     scheduler.sync = Scheduler::SynchronizeMode::CPU;
     runthreadtosave();
@@ -49,6 +59,8 @@ void System::runtosave() {
     scheduler.thread = chip.thread;
     runthreadtosave();
   }
+
+  synchronized = true;
 }
 
 void System::runthreadtosave() {
@@ -57,6 +69,7 @@ void System::runthreadtosave() {
     if(scheduler.exit_reason() == Scheduler::ExitReason::SynchronizeEvent) break;
     if(scheduler.exit_reason() == Scheduler::ExitReason::FrameEvent) {
       video.update();
+      audio.update();
     }
   }
 }
@@ -238,6 +251,7 @@ void System::reset() {
   scheduler.init();
   input.connect(0, configuration.controller_port1);
   input.connect(1, configuration.controller_port2);
+  synchronized = true;
 }
 
 void System::scanline(bool& frame_event_performed) {
@@ -251,9 +265,11 @@ void System::scanline(bool& frame_event_performed) {
 }
 
 void System::frame() {
+  if(cartridge.has_sa1()) sa1.frame();
 }
 
 System::System() {
+  synchronized = false;
   region = Region::Autodetect;
   expansion = ExpansionPortDevice::Satellaview;
 }
@@ -24,16 +24,25 @@ struct System : property<System> {
   readonly<unsigned> apu_frequency;
   readonly<unsigned> serialize_size;
 
-  serializer serialize();
+  serializer serialize(bool compress = false);
   bool unserialize(serializer&);
 
   System();
 
 private:
+  bool synchronized;  //all threads are at their entry points; state can be saved as-is
   void runthreadtosave();
 
+  //one per component with state in the loaded cartridge
+  struct Section {
+    uint32 tag;        //four characters, stored little-endian
+    unsigned version;  //bumped when this component's serialize() changes
+    unsigned size;
+    function<void (serializer&)> serialize;
+  };
+  vector<Section> sections;
+
   void serialize(serializer&);
-  void serialize_all(serializer&);
   void serialize_init();
 
   friend class Cartridge;
@@ -42,11 +51,12 @@ private:
   friend class Input;
 };
 
-extern System system;
+extern threadlocal System system;
 
 #include "video.hpp"
 #include "audio.hpp"
 #include "input.hpp"
+#include "history.hpp"
 
 #include <sfc/scheduler/scheduler.hpp>
 
@@ -56,9 +66,13 @@ struct Configuration {
   System::ExpansionPortDevice expansion_port = System::ExpansionPortDevice::Satellaview;
   System::Region region = System::Region::Autodetect;
   bool random = true;
+  bool snapshot = false;  //synchronize all threads at the end of every frame
+  unsigned sa1_budget = 0;  //clocks the SA-1 may run ahead on memory the S-CPU leaves alone; 0 = lockstep
+  unsigned armdsp_budget = 0;  //clocks the ST018 may run ahead between bridge accesses; 0 = lockstep
+  bool ppu_catchup = false;  //queue PPU register writes until the PPU reaches them (accuracy PPU only)
 };
 
-extern Configuration configuration;
+extern threadlocal Configuration configuration;
 
 struct Random {
   void seed(unsigned seed) {
@@ -78,4 +92,4 @@ private:
   unsigned iter = 0;
 };
 
-extern Random random;
+extern threadlocal Random random;
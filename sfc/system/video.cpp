@@ -1,11 +1,52 @@
 #ifdef SYSTEM_CPP
 
-Video video;
+#if defined(THREAD_INSTANCES)
+//palettes are 2MB each and never change once generated, so instances
+//look up identical ones here and keep one copy between them
+static std::mutex shared_palettes_lock;
+static struct SharedPalette {
+  uint32_t* table;
+  unsigned references;
+  SharedPalette* next;
+}* shared_palettes = nullptr;
+
+//takes ownership of table, and returns it or an identical table already in use
+const uint32_t* Video::share_palette(uint32_t* table) {
+  std::lock_guard<std::mutex> lock(shared_palettes_lock);
+  for(auto shared = shared_palettes; shared; shared = shared->next) {
+    if(memcmp(shared->table, table, sizeof(uint32_t) << 19)) continue;
+    delete[] table;
+    shared->references++;
+    return shared->table;
+  }
+  shared_palettes = new SharedPalette{table, 1, shared_palettes};
+  return table;
+}
+
+void Video::release_palette(const uint32_t* table) {
+  std::lock_guard<std::mutex> lock(shared_palettes_lock);
+  for(auto link = &shared_palettes; *link; link = &(*link)->next) {
+    auto shared = *link;
+    if(shared->table != table) continue;
+    if(--shared->references) return;
+    *link = shared->next;
+    delete[] shared->table;
+    delete shared;
+    return;
+  }
+}
+#else
+const uint32_t* Video::share_palette(uint32_t* table) { return table; }
+void Video::release_palette(const uint32_t* table) { delete[] table; }
+#endif
+
+threadlocal Video video;
 
 void Video::generate_palette(Emulator::Interface::PaletteMode mode) {
+  uint32_t* table = new uint32_t[1 << 19];
   for(unsigned color = 0; color < (1 << 19); color++) {
     if(mode == Emulator::Interface::PaletteMode::Literal) {
-      palette[color] = color;
+      table[color] = color;
       continue;
     }
 
@@ -19,7 +60,7 @@ void Video::generate_palette(Emulator::Interface::PaletteMode mode) {
       r = image::normalize(r, 5, 16);
       g = image::normalize(g, 5, 16);
       b = image::normalize(b, 5, 16);
-      palette[color] = interface->videoColor(color, l, r, g, b);
+      table[color] = interface->videoColor(color, l, r, g, b);
       continue;
     }
 
@@ -40,16 +81,44 @@ void Video::generate_palette(Emulator::Interface::PaletteMode mode) {
     unsigned G = L * image::normalize(g, 8, 16);
     unsigned B = L * image::normalize(b, 8, 16);
 
-    palette[color] = interface->videoColor(color, 0, R, G, B);
+    table[color] = interface->videoColor(color, 0, R, G, B);
+  }
+
+  release_palette(palette);
+  palette = share_palette(table);
+  generate_compact();
+}
+
+//the full palette is 2MB and is gathered from at random once per pixel;
+//when the mapping is separable, the three channel tables (6KB) stay in L1 instead
+void Video::generate_compact() {
+  compact = false;
+  for(unsigned l = 0; l < 16; l++) {
+    if(palette[l << 15] != 0) return;
+    for(unsigned n = 0; n < 32; n++) {
+      red  [l << 5 | n] = palette[l << 15 | n <<  0];
+      green[l << 5 | n] = palette[l << 15 | n <<  5];
+      blue [l << 5 | n] = palette[l << 15 | n << 10];
+    }
+  }
+
+  for(unsigned color = 0; color < (1 << 19); color++) {
+    unsigned l = (color >> 15) & 15;
+    unsigned b = (color >> 10) & 31;
+    unsigned g = (color >>  5) & 31;
+    unsigned r = (color >>  0) & 31;
+    if(palette[color] != (red[l << 5 | r] | green[l << 5 | g] | blue[l << 5 | b])) return;
   }
+  compact = true;
 }
 
 Video::Video() {
-  palette = new uint32_t[1 << 19]();
+  palette = share_palette(new uint32_t[1 << 19]());
+  compact = false;
 }
 
 Video::~Video() {
-  delete[] palette;
+  release_palette(palette);
 }
 
 //internal
@@ -1,5 +1,15 @@
 struct Video {
-  uint32_t* palette;
+  //read-only; with THREAD_INSTANCES, shared by every instance whose palette has the same colors
+  const uint32_t* palette;
+
+  //per-channel split of palette, indexed by (luma << 5 | channel);
+  //valid when compact is set, in which case palette[l << 15 | b << 10 | g << 5 | r]
+  //equals red[l << 5 | r] | green[l << 5 | g] | blue[l << 5 | b]
+  bool compact;
+  uint32_t red[16 * 32];
+  uint32_t green[16 * 32];
+  uint32_t blue[16 * 32];
+
   void generate_palette(Emulator::Interface::PaletteMode mode);
   Video();
   ~Video();
@@ -8,6 +18,10 @@ private:
   bool hires;
   unsigned line_width[240];
 
+  static const uint32_t* share_palette(uint32_t* table);
+  static void release_palette(const uint32_t* table);
+
+  void generate_compact();
   void update();
   void scanline();
   void init();
@@ -19,4 +33,4 @@ private:
   friend class System;
 };
 
-extern Video video;
+extern threadlocal Video video;
@@ -0,0 +1,591 @@
+//headless benchmark: loads each game through the libretro core, emulates a fixed number of frames
+//with video and audio discarded, and reports frames/sec plus a per-thread breakdown.
+//the emulation profile is fixed at build time: build once per PROFILE= to compare them.
+//--instances runs several systems at once on their own OS threads (needs a THREAD_INSTANCES=1 build).
+//--validate checks relaxed coprocessor synchronization budgets against lockstep, frame by frame.
+//--loads times retro_load_game() alone: the first (cold) load, then the rest (warm).
+//--resample compares the polyphase and sinc resamplers on the coprocessor audio rates (no game needed).
+//--compact runs each game through the full 2MB palette and then the per-channel tables, with cache misses.
+
+#include "../target-libretro/libretro.h"
+#include <sfc/sfc.hpp>
+#include <nall/file.hpp>
+#include <nall/crc32.hpp>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace nall;
+
+typedef std::chrono::steady_clock Clock;
+
+//every co_switch() in the core is routed here (linked with --wrap=co_switch):
+//the time since the previous switch is charged to the thread that was running
+extern "C" void __real_co_switch(cothread_t);
+extern "C" void bsnes_set_sa1_budget(unsigned clocks);
+extern "C" void bsnes_set_armdsp_budget(unsigned clocks);
+extern "C" void bsnes_set_ppu_catchup(bool enable);
+extern "C" void bsnes_set_load_cache(const char* directory);
+extern "C" void bsnes_set_compact_palette(bool enable);
+
+//clocks each coprocessor may run ahead of the S-CPU between synchronization points; 0 = lockstep.
+//ppu queues PPU register writes rather than synchronizing to the PPU for each one
+struct Budgets {
+  unsigned sa1 = 0;
+  unsigned armdsp = 0;
+  bool ppu = false;
+
+  bool relaxed() const { return sa1 || armdsp || ppu; }
+  string text() const { return {"sa1 budget ", sa1, ", armdsp budget ", armdsp, ppu ? ", ppu catch-up" : ""}; }
+  void apply() const {
+    bsnes_set_sa1_budget(sa1);
+    bsnes_set_armdsp_budget(armdsp);
+    bsnes_set_ppu_catchup(ppu);
+  }
+};
+
+namespace Benchmark {
+  struct Counter {
+    uint64_t switches = 0;
+    Clock::duration time = Clock::duration::zero();
+  };
+  std::map<cothread_t, Counter> threads;
+  Clock::time_point last;
+  bool profiling = false;
+
+  //running checksums of the output, to compare emulation modes that must agree exactly
+  bool hashing = false;
+  uint32_t videoHash = ~0;
+  uint32_t audioHash = ~0;
+
+  void hash(uint32_t& crc32, const uint8_t* data, unsigned length) {
+    for(unsigned n = 0; n < length; n++) crc32 = crc32_adjust(crc32, data[n]);
+  }
+}
+
+extern "C" void __wrap_co_switch(cothread_t thread) {
+  if(Benchmark::profiling) {
+    auto now = Clock::now();
+    auto& counter = Benchmark::threads[co_active()];
+    counter.switches++;
+    counter.time += now - Benchmark::last;
+    Benchmark::last = now;
+  }
+  __real_co_switch(thread);
+}
+
+static threadlocal string systemDirectory;
+
+static bool environment(unsigned command, void* data) {
+  switch(command) {
+  case RETRO_ENVIRONMENT_GET_OVERSCAN: *(bool*)data = false; return true;
+  case RETRO_ENVIRONMENT_GET_CAN_DUPE: *(bool*)data = true; return true;
+  case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT: return *(retro_pixel_format*)data == RETRO_PIXEL_FORMAT_XRGB8888;
+  case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY: *(const char**)data = systemDirectory; return true;
+  }
+  return false;
+}
+
+static void videoRefresh(const void* data, unsigned width, unsigned height, size_t pitch) {
+  if(Benchmark::hashing == false || data == nullptr) return;
+  for(unsigned y = 0; y < height; y++) {
+    Benchmark::hash(Benchmark::videoHash, (const uint8_t*)data + y * pitch, width * sizeof(uint32_t));
+  }
+}
+
+static size_t audioSampleBatch(const int16_t* data, size_t frames) {
+  if(Benchmark::hashing) Benchmark::hash(Benchmark::audioHash, (const uint8_t*)data, frames * 2 * sizeof(int16_t));
+  return frames;
+}
+static void inputPoll() {}
+static int16_t inputState(unsigned, unsigned, unsigned, unsigned) { return 0; }
+
+static string threadName(cothread_t thread) {
+  using namespace SuperFamicom;
+  if(thread == scheduler.host_thread) return "host";
+  if(thread == cpu.thread) return "cpu";
+  if(thread == smp.thread) return "smp";
+  if(thread == dsp.thread) return "dsp";
+  if(thread == ppu.thread) return "ppu";
+  if(input.port1 && thread == input.port1->thread) return "controller1";
+  if(input.port2 && thread == input.port2->thread) return "controller2";
+
+  struct { Thread* chip; const char* name; } chips[] = {
+    {&icd2, "icd2"}, {&event, "event"}, {&sa1, "sa1"}, {&superfx, "superfx"},
+    {&armdsp, "armdsp"}, {&hitachidsp, "hitachidsp"}, {&necdsp, "necdsp"},
+    {&epsonrtc, "epsonrtc"}, {&sharprtc, "sharprtc"}, {&spc7110, "spc7110"}, {&msu1, "msu1"},
+  };
+  for(auto& chip : chips) if(thread == chip.chip->thread) return chip.name;
+  return "other";
+}
+
+static string cartridgeType() {
+  using namespace SuperFamicom;
+  string type;
+  for(auto chip : cpu.coprocessors) type.append(threadName(chip->thread), " ");
+  if(cartridge.has_sdd1()) type.append("sdd1 ");
+  if(cartridge.has_obc1()) type.append("obc1 ");
+  type.rtrim(" ");
+  return type.empty() ? string{"rom"} : type;
+}
+
+//the libretro callbacks are per thread in a THREAD_INSTANCES build, so every instance sets them
+static void initialize() {
+  retro_set_environment(environment);
+  retro_set_video_refresh(videoRefresh);
+  retro_set_audio_sample_batch(audioSampleBatch);
+  retro_set_input_poll(inputPoll);
+  retro_set_input_state(inputState);
+  retro_init();
+}
+
+static bool run(const string& filename, unsigned frames, bool profile, bool hash) {
+  auto memory = file::read(filename);
+  if(memory.empty()) {
+    fprintf(stderr, "%s: cannot read\n", (const char*)filename);
+    return false;
+  }
+
+  systemDirectory = dir(filename);
+  retro_game_info info = {filename, memory.data(), memory.size(), nullptr};
+  if(retro_load_game(&info) == false) {
+    fprintf(stderr, "%s: cannot load\n", (const char*)filename);
+    return false;
+  }
+  retro_system_av_info av;
+  retro_get_system_av_info(&av);
+
+  Benchmark::threads.clear();
+  Benchmark::hashing = hash;
+  Benchmark::videoHash = Benchmark::audioHash = ~0;
+  Benchmark::profiling = profile;
+  Benchmark::last = Clock::now();
+  auto start = Benchmark::last;
+  for(unsigned n = 0; n < frames; n++) retro_run();
+  auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  Benchmark::profiling = false;
+  Benchmark::hashing = false;
+
+  printf("%s\n", (const char*)filename);
+  printf("  profile: %s, cartridge: %s\n", (const char*)Emulator::Profile, (const char*)cartridgeType());
+  printf("  %u frames in %.3fs: %.2f fps\n", frames, elapsed, frames / elapsed);
+
+  if(hash) {
+    printf("  video crc32: %.8x, audio crc32: %.8x\n", ~Benchmark::videoHash, ~Benchmark::audioHash);
+  }
+
+  if(profile) {
+    uint64_t switches = 0;
+    for(auto& thread : Benchmark::threads) switches += thread.second.switches;
+    printf("  %llu co_switch calls (%.0f per frame); timing adds overhead to each\n",
+      (unsigned long long)switches, (double)switches / frames);
+    for(auto& thread : Benchmark::threads) {
+      double time = std::chrono::duration<double>(thread.second.time).count();
+      printf("  %-12s %8.3fs %5.1f%% %12llu switches\n", (const char*)threadName(thread.first),
+        time, time * 100.0 / elapsed, (unsigned long long)thread.second.switches);
+    }
+  }
+
+  retro_unload_game();
+  return true;
+}
+
+//the running checksums after every frame
+static void trace(unsigned frames, std::vector<uint64_t>& hashes) {
+  hashes.clear();
+  Benchmark::hashing = true;
+  Benchmark::videoHash = Benchmark::audioHash = ~0;
+  for(unsigned n = 0; n < frames; n++) {
+    retro_run();
+    hashes.push_back((uint64_t)Benchmark::videoHash << 32 | Benchmark::audioHash);
+  }
+  Benchmark::hashing = false;
+}
+
+//relaxed synchronization is not exact: reports the first frame where it departs from lockstep
+static bool validate(const string& filename, unsigned frames, const Budgets& budgets) {
+  auto memory = file::read(filename);
+  if(memory.empty()) {
+    fprintf(stderr, "%s: cannot read\n", (const char*)filename);
+    return false;
+  }
+
+  systemDirectory = dir(filename);
+  retro_game_info info = {filename, memory.data(), memory.size(), nullptr};
+  if(retro_load_game(&info) == false) {
+    fprintf(stderr, "%s: cannot load\n", (const char*)filename);
+    return false;
+  }
+
+  //both runs start from this state, rather than from two loads: work RAM survives reloading a game
+  std::vector<uint8_t> state(retro_serialize_size());
+  retro_serialize(state.data(), state.size());
+
+  std::vector<uint64_t> lockstep, relaxed;
+  Budgets().apply();
+  trace(frames, lockstep);
+  retro_unserialize(state.data(), state.size());
+  budgets.apply();
+  trace(frames, relaxed);
+  retro_unload_game();
+
+  unsigned frame = 0;
+  while(frame < frames && lockstep[frame] == relaxed[frame]) frame++;
+  printf("%s\n", (const char*)filename);
+  if(frame == frames) {
+    printf("  %s: all %u frames match lockstep\n", (const char*)budgets.text(), frames);
+    return true;
+  }
+  bool video = (lockstep[frame] >> 32) != (relaxed[frame] >> 32);
+  printf("  %s: %s differs from lockstep at frame %u\n", (const char*)budgets.text(), video ? "video" : "audio", frame + 1);
+  return false;
+}
+
+//one engine over a whole stream, fed and drained the way Audio feeds it
+static double resampleStream(nall::DSP::ResampleEngine engine, double inputRate, const std::vector<signed>& input, std::vector<signed>& output) {
+  enum : unsigned { BlockSize = 512 };  //Audio::input_size
+  nall::DSP dsp;
+  dsp.setChannels(2);
+  dsp.setPrecision(16);
+  dsp.setFrequency(inputRate);
+  dsp.setResampler(engine);
+  dsp.setResamplerFrequency(24607104 / 768.0);
+
+  output.clear();
+  signed samples[2];
+  unsigned frames = input.size() / 2;
+  auto start = Clock::now();
+  for(unsigned offset = 0; offset < frames;) {
+    unsigned length = std::min(frames - offset, (unsigned)BlockSize);
+    if(engine == nall::DSP::ResampleEngine::Polyphase) {
+      dsp.sample(&input[offset * 2], length);
+    } else {
+      for(unsigned n = 0; n < length; n++) {
+        samples[0] = input[(offset + n) * 2 + 0];
+        samples[1] = input[(offset + n) * 2 + 1];
+        dsp.sample(samples);
+      }
+    }
+    offset += length;
+    while(dsp.pending()) {
+      dsp.read(samples);
+      output.push_back(samples[0]);
+      output.push_back(samples[1]);
+    }
+  }
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//throughput of both engines on a stereo test signal (tones up to 12kHz plus noise),
+//and how far the polyphase output strays from the sinc output, in 16-bit steps
+static bool resample() {
+  struct Source { const char* name; double rate; unsigned seconds; };
+  const Source sources[] = {{"MSU1", 44100.0, 20}, {"ICD2", 2 * 1024 * 1024, 2}};
+
+  for(auto& source : sources) {
+    unsigned frames = source.rate * source.seconds;
+    std::vector<signed> input(frames * 2);
+    uint32_t noise = 1;
+    for(unsigned n = 0; n < frames; n++) {
+      double t = n / source.rate;
+      double tone = 0.3 * sin(2 * M_PI * 440 * t) + 0.2 * sin(2 * M_PI * 3000 * t) + 0.1 * sin(2 * M_PI * 12000 * t);
+      noise = noise * 1664525 + 1013904223;
+      input[n * 2 + 0] = (signed)(32767 * (tone + 0.05 * ((signed)(noise >> 16) - 32768) / 32768.0));
+      input[n * 2 + 1] = (signed)(32767 * -tone);
+    }
+
+    std::vector<signed> sinc, polyphase;
+    double sincTime = resampleStream(nall::DSP::ResampleEngine::Sinc, source.rate, input, sinc);
+    double polyphaseTime = resampleStream(nall::DSP::ResampleEngine::Polyphase, source.rate, input, polyphase);
+
+    unsigned length = std::min(sinc.size(), polyphase.size());
+    unsigned peak = 0;
+    double squares = 0;
+    for(unsigned n = 0; n < length; n++) {
+      signed difference = polyphase[n] - sinc[n];
+      peak = std::max(peak, (unsigned)abs(difference));
+      squares += (double)difference * difference;
+    }
+
+    printf("%s: %.0fHz -> %.1fHz, %us of stereo input\n", source.name, source.rate, 24607104 / 768.0, source.seconds);
+    printf("  sinc       %.3fs: %6.2fM frames/s, %u frames out\n", sincTime, frames / sincTime / 1e6, (unsigned)sinc.size() / 2);
+    printf("  polyphase  %.3fs: %6.2fM frames/s, %u frames out (%.2fx)\n", polyphaseTime, frames / polyphaseTime / 1e6,
+      (unsigned)polyphase.size() / 2, sincTime / polyphaseTime);
+    printf("  difference from sinc: peak %u, rms %.3f\n", peak, length ? sqrt(squares / length) : 0.0);
+  }
+  return true;
+}
+
+//hardware cache miss counters for the calling thread, where the kernel allows them
+struct CacheMisses {
+  enum : unsigned { L1D, LLC, Count };
+  int fd[Count];
+  uint64_t value[Count];
+
+  CacheMisses() {
+    for(unsigned n = 0; n < Count; n++) fd[n] = -1, value[n] = 0;
+    #if defined(__linux__)
+    uint64_t configs[Count] = {
+      PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+      PERF_COUNT_HW_CACHE_LL  | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+    };
+    for(unsigned n = 0; n < Count; n++) {
+      perf_event_attr attr = {0};
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = configs[n];
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd[n] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    #endif
+  }
+
+  ~CacheMisses() {
+    #if defined(__linux__)
+    for(unsigned n = 0; n < Count; n++) if(fd[n] >= 0) close(fd[n]);
+    #endif
+  }
+
+  bool available() const { return fd[L1D] >= 0 || fd[LLC] >= 0; }
+
+  void start() {
+    #if defined(__linux__)
+    for(unsigned n = 0; n < Count; n++) if(fd[n] >= 0) ioctl(fd[n], PERF_EVENT_IOC_RESET, 0), ioctl(fd[n], PERF_EVENT_IOC_ENABLE, 0);
+    #endif
+  }
+
+  void stop() {
+    #if defined(__linux__)
+    for(unsigned n = 0; n < Count; n++) {
+      if(fd[n] < 0) continue;
+      ioctl(fd[n], PERF_EVENT_IOC_DISABLE, 0);
+      if(::read(fd[n], &value[n], sizeof(uint64_t)) != sizeof(uint64_t)) value[n] = 0;
+    }
+    #endif
+  }
+
+  string text(unsigned id, unsigned frames) const {
+    if(fd[id] < 0) return "n/a";
+    return {(unsigned)(value[id] / frames), "/frame"};
+  }
+};
+
+//the same frames converted through the full palette and through the per-channel tables:
+//both start from one state, and must produce identical output
+static bool compact(const string& filename, unsigned frames) {
+  auto memory = file::read(filename);
+  if(memory.empty()) {
+    fprintf(stderr, "%s: cannot read\n", (const char*)filename);
+    return false;
+  }
+
+  systemDirectory = dir(filename);
+  retro_game_info info = {filename, memory.data(), memory.size(), nullptr};
+  if(retro_load_game(&info) == false) {
+    fprintf(stderr, "%s: cannot load\n", (const char*)filename);
+    return false;
+  }
+
+  std::vector<uint8_t> state(retro_serialize_size());
+  retro_serialize(state.data(), state.size());
+
+  printf("%s\n", (const char*)filename);
+  printf("  palette tables %s\n", SuperFamicom::video.compact ? "apply" : "do not apply: both runs use the full palette");
+  CacheMisses misses;
+  if(misses.available() == false) printf("  cache miss counters unavailable (perf_event_open denied)\n");
+
+  uint32_t hashes[2];
+  for(unsigned pass = 0; pass < 2; pass++) {
+    retro_unserialize(state.data(), state.size());
+    bsnes_set_compact_palette(pass == 1);
+    Benchmark::hashing = true;
+    Benchmark::videoHash = ~0;
+    auto start = Clock::now();
+    misses.start();
+    for(unsigned n = 0; n < frames; n++) retro_run();
+    misses.stop();
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    Benchmark::hashing = false;
+    hashes[pass] = ~Benchmark::videoHash;
+    printf("  %-8s %u frames in %.3fs: %.2f fps, L1D misses %s, LLC misses %s, video crc32: %.8x\n",
+      pass == 0 ? "full" : "compact", frames, elapsed, frames / elapsed,
+      (const char*)misses.text(CacheMisses::L1D, frames), (const char*)misses.text(CacheMisses::LLC, frames), hashes[pass]);
+  }
+  bsnes_set_compact_palette(true);
+  retro_unload_game();
+
+  if(hashes[0] != hashes[1]) printf("  video output differs between the palettes\n");
+  return hashes[0] == hashes[1];
+}
+
+//the first load may have to fill the load cache (--load-cache); the rest are served from it
+static bool loads(const string& filename, unsigned count) {
+  auto memory = file::read(filename);
+  if(memory.empty()) {
+    fprintf(stderr, "%s: cannot read\n", (const char*)filename);
+    return false;
+  }
+
+  systemDirectory = dir(filename);
+  retro_game_info info = {filename, memory.data(), memory.size(), nullptr};
+  double first = 0, rest = 0;
+  for(unsigned n = 0; n < count; n++) {
+    auto start = Clock::now();
+    bool load = retro_load_game(&info);
+    auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if(load == false) {
+      fprintf(stderr, "%s: cannot load\n", (const char*)filename);
+      return false;
+    }
+    retro_unload_game();
+    if(n == 0) first = elapsed;
+    else rest += elapsed;
+  }
+
+  printf("%s\n", (const char*)filename);
+  printf("  first load %.2fms", first);
+  if(count > 1) printf(", then %.2fms mean over %u loads", rest / (count - 1), count - 1);
+  printf("\n");
+  return true;
+}
+
+//emulates the same game on several threads at once; each thread owns a complete system
+static bool scale(const string& filename, unsigned frames, unsigned instances, const Budgets& budgets) {
+  #if !defined(THREAD_INSTANCES)
+  fprintf(stderr, "--instances requires a build with THREAD_INSTANCES=1\n");
+  return false;
+  #endif
+
+  auto memory = file::read(filename);
+  if(memory.empty()) {
+    fprintf(stderr, "%s: cannot read\n", (const char*)filename);
+    return false;
+  }
+
+  //only the frame loops are timed, from the first to start until the last to finish
+  std::atomic<unsigned> loaded(0);
+  std::atomic<bool> result(true);
+  std::vector<Clock::time_point> starts(instances), ends(instances);
+  auto instance = [&](unsigned n) {
+    initialize();
+    budgets.apply();
+    systemDirectory = dir(filename);
+    retro_game_info info = {filename, memory.data(), memory.size(), nullptr};
+    bool load = retro_load_game(&info);
+    if(load == false) result = false;
+    for(loaded++; loaded < instances;) std::this_thread::yield();
+
+    starts[n] = Clock::now();
+    if(load) for(unsigned frame = 0; frame < frames; frame++) retro_run();
+    ends[n] = Clock::now();
+
+    if(load) retro_unload_game();
+    retro_deinit();
+  };
+
+  std::vector<std::thread> pool;
+  for(unsigned n = 0; n < instances; n++) pool.emplace_back(instance, n);
+  for(auto& thread : pool) thread.join();
+  if(result == false) {
+    fprintf(stderr, "%s: cannot load\n", (const char*)filename);
+    return false;
+  }
+
+  auto start = *std::min_element(starts.begin(), starts.end());
+  auto end = *std::max_element(ends.begin(), ends.end());
+  auto elapsed = std::chrono::duration<double>(end - start).count();
+  printf("%s\n", (const char*)filename);
+  printf("  profile: %s, %u instances\n", (const char*)Emulator::Profile, instances);
+  printf("  %u frames each in %.3fs: %.2f fps combined, %.2f fps per instance\n",
+    frames, elapsed, frames * instances / elapsed, frames / elapsed);
+  #if defined(__linux__)
+  //instances share their palette and (mapped) ROM images, so this grows by less than one system each
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  printf("  peak resident memory %.1fMB, hardware concurrency %u\n", usage.ru_maxrss / 1024.0, std::thread::hardware_concurrency());
+  #endif
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned frames = 600;
+  bool profile = false;
+  bool hash = false;
+  unsigned instances = 0;
+  Budgets budgets;
+  bool validation = false;
+  unsigned loadcount = 0;
+  string loadcache;
+  bool palettes = false;
+  bool resampling = false;
+  lstring filenames;
+
+  for(unsigned n = 1; n < argc; n++) {
+    string argument = argv[n];
+    if(argument == "--profile") profile = true;
+    else if(argument == "--hash") hash = true;
+    else if(argument == "--frames" && n + 1 < argc) frames = decimal(argv[++n]);
+    else if(argument == "--instances" && n + 1 < argc) instances = decimal(argv[++n]);
+    else if(argument == "--sa1-budget" && n + 1 < argc) budgets.sa1 = decimal(argv[++n]);
+    else if(argument == "--armdsp-budget" && n + 1 < argc) budgets.armdsp = decimal(argv[++n]);
+    else if(argument == "--ppu-catchup") budgets.ppu = true;
+    else if(argument == "--validate") validation = true;
+    else if(argument == "--loads" && n + 1 < argc) loadcount = decimal(argv[++n]);
+    else if(argument == "--load-cache" && n + 1 < argc) loadcache = argv[++n];
+    else if(argument == "--compact") palettes = true;
+    else if(argument == "--resample") resampling = true;
+    else filenames.append(argument);
+  }
+
+  if(resampling) return resample() ? 0 : 1;
+
+  if(filenames.size() == 0 || frames == 0 || (validation && !budgets.relaxed())) {
+    fprintf(stderr, "usage: %s [--frames N] [--profile] [--hash] [--instances N] [--sa1-budget N] [--armdsp-budget N] [--ppu-catchup] [--validate] [--loads N] [--load-cache DIR] [--compact] game.sfc|manifest.bml ...\n", argv[0]);
+    fprintf(stderr, "   or: %s --resample\n", argv[0]);
+    fprintf(stderr, "  --frames N  frames to emulate per game (default 600)\n");
+    fprintf(stderr, "  --profile   report time and co_switch calls per emulated thread\n");
+    fprintf(stderr, "  --hash      report checksums of all video and audio output\n");
+    fprintf(stderr, "  --instances N  run N systems concurrently on N threads and report combined fps\n");
+    fprintf(stderr, "  --sa1-budget N  let the SA-1 run up to N clocks ahead on memory the S-CPU leaves alone\n");
+    fprintf(stderr, "  --armdsp-budget N  let the ST018 run up to N clocks ahead between bridge accesses\n");
+    fprintf(stderr, "  --ppu-catchup  queue PPU register writes until the accuracy PPU reaches them\n");
+    fprintf(stderr, "  --validate  compare each frame's output at those budgets against lockstep\n");
+    fprintf(stderr, "  --loads N   time N loads of each game instead of emulating it\n");
+    fprintf(stderr, "  --load-cache DIR  keep manifests of loaded games in DIR\n");
+    fprintf(stderr, "  --resample  compare the polyphase and sinc resamplers on the coprocessor audio rates\n");
+    fprintf(stderr, "  --compact   compare video conversion through the full palette and the per-channel tables\n");
+    return 1;
+  }
+
+  bool result = true;
+  if(instances) {
+    for(auto& filename : filenames) result &= scale(filename, frames, instances, budgets);
+    return result ? 0 : 1;
+  }
+
+  initialize();
+  if(!loadcache.empty()) bsnes_set_load_cache(loadcache);
+  if(loadcount) {
+    for(auto& filename : filenames) result &= loads(filename, loadcount);
+  } else if(palettes) {
+    for(auto& filename : filenames) result &= compact(filename, frames);
+  } else if(validation) {
+    for(auto& filename : filenames) result &= validate(filename, frames, budgets);
+  } else {
+    budgets.apply();
+    for(auto& filename : filenames) result &= run(filename, frames, profile, hash);
+  }
+
+  retro_deinit();
+  return result ? 0 : 1;
+}
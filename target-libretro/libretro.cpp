@@ -2,9 +2,13 @@
 #include <sfc/sfc.hpp>
 #include <nall/stream/mmap.hpp>
 #include <nall/stream/file.hpp>
+#include <nall/crc32.hpp>
 #include "../ananke/heuristics/super-famicom.hpp"
 #include "../ananke/heuristics/game-boy.hpp"
 #include <string>
+#include <chrono>
+#include <memory>
+#include <vector>
 
 // Special memory types.
 #define RETRO_MEMORY_SNES_BSX_RAM             ((1 << 8) | RETRO_MEMORY_SAVE_RAM)
@@ -28,41 +32,38 @@
 
 using namespace nall;
 
-const uint8 iplrom[64] = {
-/*ffc0*/  0xcd, 0xef,        //mov   x,#$ef
-/*ffc2*/  0xbd,              //mov   sp,x
-/*ffc3*/  0xe8, 0x00,        //mov   a,#$00
-/*ffc5*/  0xc6,              //mov   (x),a
-/*ffc6*/  0x1d,              //dec   x
-/*ffc7*/  0xd0, 0xfc,        //bne   $ffc5
-/*ffc9*/  0x8f, 0xaa, 0xf4,  //mov   $f4,#$aa
-/*ffcc*/  0x8f, 0xbb, 0xf5,  //mov   $f5,#$bb
-/*ffcf*/  0x78, 0xcc, 0xf4,  //cmp   $f4,#$cc
-/*ffd2*/  0xd0, 0xfb,        //bne   $ffcf
-/*ffd4*/  0x2f, 0x19,        //bra   $ffef
-/*ffd6*/  0xeb, 0xf4,        //mov   y,$f4
-/*ffd8*/  0xd0, 0xfc,        //bne   $ffd6
-/*ffda*/  0x7e, 0xf4,        //cmp   y,$f4
-/*ffdc*/  0xd0, 0x0b,        //bne   $ffe9
-/*ffde*/  0xe4, 0xf5,        //mov   a,$f5
-/*ffe0*/  0xcb, 0xf4,        //mov   $f4,y
-/*ffe2*/  0xd7, 0x00,        //mov   ($00)+y,a
-/*ffe4*/  0xfc,              //inc   y
-/*ffe5*/  0xd0, 0xf3,        //bne   $ffda
-/*ffe7*/  0xab, 0x01,        //inc   $01
-/*ffe9*/  0x10, 0xef,        //bpl   $ffda
-/*ffeb*/  0x7e, 0xf4,        //cmp   y,$f4
-/*ffed*/  0x10, 0xeb,        //bpl   $ffda
-/*ffef*/  0xba, 0xf6,        //movw  ya,$f6
-/*fff1*/  0xda, 0x00,        //movw  $00,ya
-/*fff3*/  0xba, 0xf4,        //movw  ya,$f4
-/*fff5*/  0xc4, 0xf4,        //mov   $f4,a
-/*fff7*/  0xdd,              //mov   a,y
-/*fff8*/  0x5d,              //mov   x,a
-/*fff9*/  0xd0, 0xdb,        //bne   $ffd6
-/*fffb*/  0x1f, 0x00, 0x00,  //jmp   ($0000+x)
-/*fffe*/  0xc0, 0xff         //reset vector location ($ffc0)
-};
+#include "iplrom.hpp"
+
+//palette conversion is a table gather; unrolled so the independent loads overlap
+template<typename T> static void convert_line(T *out, const uint32_t *data, const uint32_t *palette, unsigned width) {
+  unsigned x = 0;
+  for (; x + 4 <= width; x += 4) {
+    T a = palette[data[x + 0]], b = palette[data[x + 1]];
+    T c = palette[data[x + 2]], d = palette[data[x + 3]];
+    out[x + 0] = a, out[x + 1] = b, out[x + 2] = c, out[x + 3] = d;
+  }
+  for (; x < width; x++) out[x] = palette[data[x]];
+}
+
+//separable palette: three lookups into the 6KB per-channel tables instead of one into the 2MB palette
+template<typename T> static void convert_line_compact(T *out, const uint32_t *data, unsigned width) {
+  const uint32_t *red = SuperFamicom::video.red;
+  const uint32_t *green = SuperFamicom::video.green;
+  const uint32_t *blue = SuperFamicom::video.blue;
+  for (unsigned x = 0; x < width; x++) {
+    uint32_t color = data[x];
+    unsigned l = (color >> 10) & (15 << 5);
+    out[x] = red[l | (color & 31)] | green[l | ((color >> 5) & 31)] | blue[l | ((color >> 10) & 31)];
+  }
+}
+
+template<typename T> static void convert_frame(T *out, size_t out_pitch, const uint32_t *data, unsigned pitch,
+  const uint32_t *palette, unsigned width, unsigned height, bool compact) {
+  for (unsigned y = 0; y < height; y++, data += pitch >> 2, out = (T*)((uint8_t*)out + out_pitch)) {
+    if (compact) convert_line_compact(out, data, width);
+    else convert_line(out, data, palette, width);
+  }
+}
 
 struct Callbacks : Emulator::Interface::Bind {
   retro_video_refresh_t pvideo_refresh;
@@ -76,6 +77,7 @@ struct Callbacks : Emulator::Interface::Bind {
   bool load_request_error;
   const uint8_t *rom_data;
   unsigned rom_size;
+  bool rom_shared;  //rom_data lies in one of maps, and may be mapped by the core directly
   const uint8_t *gb_rom_data;
   unsigned gb_rom_size;
   string xmlrom;
@@ -87,8 +89,25 @@ struct Callbacks : Emulator::Interface::Bind {
   Emulator::Interface *iface;
   string basename;
 
+  //read-only file mappings backing the loaded cartridge's ROMs: the pages are
+  //shared with every other instance and process mapping the same file
+  std::vector<std::unique_ptr<filemap>> maps;
+
   bool input_polled;
 
+  //run-ahead: frames emulated past the presented one are discarded, so their
+  //output is skipped rather than converted
+  bool video_skip;
+  bool frame_snapshot;
+  unsigned runahead_frames;
+  unsigned runahead_cost;  //microseconds spent on hidden frames and state transfer last retro_run()
+  serializer runahead_state;
+
+  bool compress_states;  //retro_serialize() output is LZ4 compressed per section
+  bool full_palette;  //convert through the 2MB palette even when the channel tables apply
+
+  string load_cache;  //directory of manifests from earlier loads; empty = disabled
+
   static unsigned snes_to_retro(unsigned device) {
     switch ((SuperFamicom::Input::Device)device) {
        default:
@@ -132,6 +151,8 @@ struct Callbacks : Emulator::Interface::Bind {
   };
 
   void videoRefresh(const uint32_t *palette, const uint32_t *data, unsigned pitch, unsigned width, unsigned height) {
+    if (video_skip) return;
+
     if (!overscan) {
       data += 8 * 1024;
 
@@ -141,23 +162,30 @@ struct Callbacks : Emulator::Interface::Bind {
         height = 448;
     }
 
+    //convert straight into the frontend's framebuffer when it offers one in our format
+    retro_pixel_format format = video_fmt == video_fmt_32 ? RETRO_PIXEL_FORMAT_XRGB8888
+                              : video_fmt == video_fmt_16 ? RETRO_PIXEL_FORMAT_RGB565 : RETRO_PIXEL_FORMAT_0RGB1555;
+    retro_framebuffer fb = {0};
+    fb.width = width;
+    fb.height = height;
+    fb.access_flags = RETRO_MEMORY_ACCESS_WRITE;
+    bool direct = penviron(RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER, &fb)
+      && fb.data && fb.format == format && fb.width >= width && fb.height >= height;
+    bool compact = palette == SuperFamicom::video.palette && SuperFamicom::video.compact && !full_palette;
+
     if (video_fmt == video_fmt_32)
     {
-      uint32_t *ptr = video_buffer;
-      for (unsigned y = 0; y < height; y++, data += pitch >> 2, ptr += width)
-         for (unsigned x = 0; x < width; x++)
-            ptr[x] = palette[data[x]];
-      
-      pvideo_refresh(video_buffer, width, height, width*sizeof(uint32_t));
+      uint32_t *ptr = direct ? (uint32_t*)fb.data : video_buffer;
+      size_t ptr_pitch = direct ? fb.pitch : width*sizeof(uint32_t);
+      convert_frame(ptr, ptr_pitch, data, pitch, palette, width, height, compact);
+      pvideo_refresh(ptr, width, height, ptr_pitch);
     }
     else
     {
-      uint16_t *ptr = video_buffer_16;
-      for (unsigned y = 0; y < height; y++, data += pitch >> 2, ptr += width)
-         for (unsigned x = 0; x < width; x++)
-            ptr[x] = palette[data[x]];
-      
-      pvideo_refresh(video_buffer_16, width, height, width*sizeof(uint16_t));
+      uint16_t *ptr = direct ? (uint16_t*)fb.data : video_buffer_16;
+      size_t ptr_pitch = direct ? fb.pitch : width*sizeof(uint16_t);
+      convert_frame(ptr, ptr_pitch, data, pitch, palette, width, height, compact);
+      pvideo_refresh(ptr, width, height, ptr_pitch);
     }
   }
 
@@ -174,6 +202,15 @@ struct Callbacks : Emulator::Interface::Bind {
     }
   }
 
+  void audioSamples(const int16_t *samples, unsigned frames)
+  {
+    if (sampleBufPos) {
+      paudio(sampleBuf, sampleBufPos/2);
+      sampleBufPos = 0;
+    }
+    paudio(samples, frames);
+  }
+
   int16_t inputPoll(unsigned port, unsigned device, unsigned id) {
     if(id > 11) return 0;
     if (!input_polled)
@@ -193,6 +230,14 @@ struct Callbacks : Emulator::Interface::Bind {
     }
   }
 
+  bool shareFile(unsigned id, const string& filename) {
+    std::unique_ptr<filemap> fp(new filemap(filename, filemap::mode::read));
+    if(fp->open() == false) return false;
+    if(SuperFamicom::interface->share(id, fp->data(), fp->size()) == false) return false;
+    maps.push_back(std::move(fp));
+    return true;
+  }
+
   void loadFile(unsigned id, string p) {
     // Look for BIOS in system directory as well.
     const char *dir = 0;
@@ -200,6 +245,7 @@ struct Callbacks : Emulator::Interface::Bind {
 
     string load_path = {path(0), p};
     if(manifest || file::exists(load_path)) {
+      if(shareFile(id, load_path)) return;
       filestream stream(load_path, file::mode::read);
       iface->load(id, stream);
     } else if(dir) {
@@ -218,6 +264,7 @@ struct Callbacks : Emulator::Interface::Bind {
   }
 
   void loadROM(unsigned id) {
+    if(rom_shared && SuperFamicom::interface->share(id, rom_data, rom_size)) return;
     memorystream stream(rom_data, rom_size);
     iface->load(id, stream);
   }
@@ -372,7 +419,7 @@ struct Callbacks : Emulator::Interface::Bind {
   }
 };
 
-static Callbacks core_bind;
+static threadlocal Callbacks core_bind;
 
 struct Interface : public SuperFamicom::Interface {
   SuperFamicomCartridge::Mode mode;
@@ -391,8 +438,8 @@ struct GBInterface : public GameBoy::Interface {
   }
 };
 
-static Interface core_interface;
-static GBInterface core_gb_interface;
+static threadlocal Interface core_interface;
+static threadlocal GBInterface core_gb_interface;
 
 Interface::Interface() {
   bind = &core_bind;
@@ -508,9 +555,37 @@ void retro_reset(void) {
   SuperFamicom::system.reset();
 }
 
+static void run_ahead(void) {
+  //the real frame: its audio is heard, but its video is superseded below
+  core_bind.video_skip = true;
+  SuperFamicom::system.run();
+
+  auto start = std::chrono::steady_clock::now();
+  SuperFamicom::system.runtosave();
+  core_bind.runahead_state = SuperFamicom::system.serialize();
+
+  //hidden frames and the rewind: the audio is suspended rather than discarded at the interface,
+  //so that neither the coprocessor buffers nor the resampler see them, and the power-on inside
+  //unserialize() does not clear what the real frame left pending for the next one
+  SuperFamicom::audio.suspend(true);
+  for (unsigned n = 1; n < core_bind.runahead_frames; n++)
+    SuperFamicom::system.run();
+  core_bind.video_skip = false;
+  SuperFamicom::system.run();
+
+  serializer s = serializer::view(core_bind.runahead_state.data(), core_bind.runahead_state.size());
+  SuperFamicom::system.unserialize(s);
+  SuperFamicom::audio.suspend(false);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  core_bind.runahead_cost = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
 void retro_run(void) {
   core_bind.input_polled=false;
-  SuperFamicom::system.run();
+  if (core_bind.runahead_frames)
+    run_ahead();
+  else
+    SuperFamicom::system.run();
   if(core_bind.sampleBufPos) {
     core_bind.paudio(core_bind.sampleBuf, core_bind.sampleBufPos/2);
     core_bind.sampleBufPos = 0;
@@ -523,17 +598,97 @@ size_t retro_serialize_size(void) {
 
 bool retro_serialize(void *data, size_t size) {
   SuperFamicom::system.runtosave();
-  serializer s = SuperFamicom::system.serialize();
+  serializer s = SuperFamicom::system.serialize(core_bind.compress_states);
   if(s.size() > size) return false;
   memcpy(data, s.data(), s.size());
   return true;
 }
 
 bool retro_unserialize(const void *data, size_t size) {
-  serializer s((const uint8_t*)data, size);
+  serializer s = serializer::view((const uint8_t*)data, size);
   return SuperFamicom::system.unserialize(s);
 }
 
+//snapshot extension: align all threads at the end of every retro_run(), so
+//that frontends serializing once per frame (netplay, run-ahead) pay no
+//extra emulation in retro_serialize()
+extern "C" void bsnes_set_frame_snapshot(bool enable) {
+  core_bind.frame_snapshot = enable;
+  SuperFamicom::configuration.snapshot = core_bind.frame_snapshot || core_bind.runahead_frames;
+}
+
+//run-ahead extension: emulate the given number of frames past the current one
+//each retro_run(), present the last, then rewind; hides that many frames of
+//the game's own input lag. the frame snapshot point keeps the per-frame save free
+extern "C" void bsnes_set_run_ahead(unsigned frames) {
+  core_bind.runahead_frames = frames;
+  core_bind.runahead_cost = 0;
+  if (!frames) core_bind.runahead_state = serializer();
+  SuperFamicom::configuration.snapshot = core_bind.frame_snapshot || core_bind.runahead_frames;
+}
+
+extern "C" unsigned bsnes_get_run_ahead_cost(void) {
+  return core_bind.runahead_cost;
+}
+
+//compression extension: retro_serialize() compresses each section of the state.
+//states are smaller (retro_serialize_size() stays the uncompressed bound), but slower to save;
+//retro_unserialize() accepts either form
+extern "C" void bsnes_set_state_compression(bool enable) {
+  core_bind.compress_states = enable;
+}
+
+//palette extension: convert video through the per-channel tables when the palette allows
+//it (the default), or always through the full palette; the output is identical either way
+extern "C" void bsnes_set_compact_palette(bool enable) {
+  core_bind.full_palette = !enable;
+}
+
+//load cache extension: keep the manifest of each game loaded in the given directory,
+//so that loading it again skips the header heuristics. entries are keyed by CRC32 and
+//size of the ROM, and checked against the SHA-256 of the loaded images; pass nullptr to disable
+extern "C" void bsnes_set_load_cache(const char* directory) {
+  core_bind.load_cache = directory ? directory : "";
+}
+
+//SA-1 extension: let the SA-1 run up to the given number of master clocks ahead of
+//the S-CPU while it stays on I-RAM/BW-RAM pages the S-CPU has not touched for a frame.
+//fewer context switches, but not exact: compare against 0 (lockstep) per game
+extern "C" void bsnes_set_sa1_budget(unsigned clocks) {
+  SuperFamicom::configuration.sa1_budget = clocks;
+}
+
+//ST018 extension: let the ARM run up to the given number of clocks ahead of the
+//S-CPU between accesses to the bridge registers. likewise inexact
+extern "C" void bsnes_set_armdsp_budget(unsigned clocks) {
+  SuperFamicom::configuration.armdsp_budget = clocks;
+}
+
+//PPU catch-up extension: the accuracy PPU queues register writes and applies each one
+//when it reaches the time it was made, instead of the S-CPU switching to it for every
+//write. exact, and has no effect on the other profiles
+extern "C" void bsnes_set_ppu_catchup(bool enable) {
+  SuperFamicom::configuration.ppu_catchup = enable;
+}
+
+//rewind extension: delta-compressed history kept inside the core, so frontends
+//need not store a full retro_serialize() snapshot for every step
+extern "C" void bsnes_rewind_init(size_t capacity) {
+  SuperFamicom::history.reset(capacity);
+}
+
+extern "C" bool bsnes_rewind_push(void) {
+  return SuperFamicom::history.push();
+}
+
+extern "C" bool bsnes_rewind_pop(void) {
+  return SuperFamicom::history.pop();
+}
+
+extern "C" unsigned bsnes_rewind_count(void) {
+  return SuperFamicom::history.size();
+}
+
 void retro_cheat_reset(void) {
   SuperFamicom::cheat.reset();
 }
@@ -746,14 +901,38 @@ void retro_get_system_av_info(struct retro_system_av_info *info) {
 static bool snes_load_cartridge_normal(
   const char *rom_xml, const uint8_t *rom_data, unsigned rom_size
 ) {
-  string xmlrom = (rom_xml && *rom_xml) ? string(rom_xml) : SuperFamicomCartridge(rom_data, rom_size).markup;
+  string xmlrom = (rom_xml && *rom_xml) ? string(rom_xml) : string();
+
+  //the load cache keeps the heuristics' manifest per game, keyed by CRC32 and size of
+  //the ROM, along with the SHA-256 of the loaded images to confirm a hit against
+  string cachename;
+  bool cached = false;
+  if (xmlrom.empty() && !core_bind.load_cache.empty()) {
+    cachename = {core_bind.load_cache, "/", hex<8>(crc32_calculate(rom_data, rom_size)), "-", hex(rom_size), ".bml"};
+    xmlrom = string::read(cachename);
+    cached = !xmlrom.empty();
+  }
+  if (xmlrom.empty()) xmlrom = SuperFamicomCartridge(rom_data, rom_size).markup;
 
   core_bind.rom_data = rom_data;
   core_bind.rom_size = rom_size;
   core_bind.xmlrom   = xmlrom;
   fprintf(stderr, "[bsnes2014]: XML map:\n%s\n", (const char*)xmlrom);
   core_bind.iface->load(SuperFamicom::ID::SuperFamicom);
+
+  //a different ROM with the same CRC32 and size: load it through the heuristics, and let
+  //that replace the entry
+  if (cached && Markup::Document(xmlrom)["information/sha256"].text() != SuperFamicom::cartridge.sha256()) {
+    fprintf(stderr, "[bsnes2014]: Load cache entry \"%s\" is for another ROM.\n", (const char*)cachename);
+    SuperFamicom::cartridge.unload();
+    file::remove(cachename);
+    return snes_load_cartridge_normal(rom_xml, rom_data, rom_size);
+  }
   SuperFamicom::system.power();
+
+  if (!cachename.empty() && !cached && !core_bind.load_request_error) {
+    file::write(cachename, string{xmlrom, "information\n  sha256: ", SuperFamicom::cartridge.sha256(), "\n"});
+  }
   return !core_bind.load_request_error;
 }
 
@@ -915,6 +1094,19 @@ bool retro_load_game(const struct retro_game_info *info)
 
   const uint8_t *data = (const uint8_t*)info->data;
   size_t size = info->size;
+
+  // Map ROMs from the content file rather than copying the frontend's buffer,
+  // unless the frontend altered the content (decompressed, soft-patched, ...).
+  core_bind.rom_shared = false;
+  if (info->path && !core_bind.manifest && data) {
+    std::unique_ptr<filemap> fp(new filemap(info->path, filemap::mode::read));
+    if (fp->open() && fp->size() == size && !memcmp(fp->data(), data, size)) {
+      data = fp->data();
+      core_bind.rom_shared = true;
+      core_bind.maps.push_back(std::move(fp));
+    }
+  }
+
   if ((size & 0x7ffff) == 512) {
     size -= 512;
     data += 512;
@@ -946,6 +1138,7 @@ bool retro_load_game(const struct retro_game_info *info)
 bool retro_load_game_special(unsigned game_type,
       const struct retro_game_info *info, size_t num_info) {
   core_bind.manifest = false;
+  core_bind.rom_shared = false;
   init_descriptors();
   const uint8_t *data = (const uint8_t*)info[0].data;
   size_t size = info[0].size;
@@ -1021,7 +1214,10 @@ bool retro_load_game_special(unsigned game_type,
 
 void retro_unload_game(void) {
   core_bind.iface->save();
+  SuperFamicom::history.reset(0);
   SuperFamicom::cartridge.unload();
+  core_bind.maps.clear();
+  core_bind.rom_shared = false;
   core_bind.sram = nullptr;
   core_bind.sram_size = 0;
 }
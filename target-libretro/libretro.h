@@ -637,6 +637,17 @@ enum retro_mod
                                            // The core must pass an array of const struct retro_controller_info which is terminated with
                                            // a blanked out struct. Each element of the struct corresponds to an ascending port index to retro_set_controller_port_device().
                                            // Even if special device types are set in the libretro core, libretro should only poll input based on the base input device types.
+#define RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER (40 | RETRO_ENVIRONMENT_EXPERIMENTAL)
+                                           // struct retro_framebuffer * --
+                                           // Returns a preallocated framebuffer which the core can use for rendering the frame into
+                                           // when not using SET_HW_RENDER. The framebuffer returned from this call must not be used
+                                           // after the current call to retro_run() returns.
+                                           //
+                                           // The core fills in width, height and access_flags; the frontend fills in data, pitch, format
+                                           // and memory_flags. If the call succeeds, the core may render into data and pass that same
+                                           // pointer to retro_video_refresh_t, saving the frontend a copy.
+                                           // If the format is not the one the core uses, the core must not use the framebuffer.
+                                           //
 
 struct retro_controller_description
 {
@@ -1111,6 +1122,21 @@ enum retro_pixel_format
    RETRO_PIXEL_FORMAT_UNKNOWN  = INT_MAX
 };
 
+#define RETRO_MEMORY_ACCESS_WRITE (1 << 0) // The core will write to the buffer provided by retro_framebuffer::data.
+#define RETRO_MEMORY_ACCESS_READ (1 << 1) // The core will read from retro_framebuffer::data.
+#define RETRO_MEMORY_TYPE_CACHED (1 << 0) // The memory in data is cached. If not cached, random writes and/or reading from the buffer is expected to be very slow.
+
+struct retro_framebuffer
+{
+   void *data;                      // The framebuffer which the core can render into. Set by frontend in GET_CURRENT_SOFTWARE_FRAMEBUFFER.
+   unsigned width;                  // The framebuffer width used by the core. Set by core.
+   unsigned height;                 // The framebuffer height used by the core. Set by core.
+   size_t pitch;                    // The number of bytes between the beginning of a scanline, and beginning of the next scanline. Set by frontend.
+   enum retro_pixel_format format;  // The pixel format the core must use to render into data. Set by frontend.
+   unsigned access_flags;           // How the core will access the memory in the framebuffer (RETRO_MEMORY_ACCESS_* flags). Set by core.
+   unsigned memory_flags;           // Flags telling core how the memory has been mapped (RETRO_MEMORY_TYPE_* flags). Set by frontend.
+};
+
 struct retro_message
 {
    const char *msg;        // Message to be displayed.
@@ -0,0 +1,219 @@
+#include <processor/processor.hpp>
+#include "engine.hpp"
+#include "../target-libretro/iplrom.hpp"
+
+#include "../sfc/alt/dsp/SPC_DSP.cpp"
+
+using namespace nall;
+
+SPCEngine::SPCEngine() {
+  memset(apuram, 0, sizeof(apuram));
+  dsp.init(apuram);
+}
+
+bool SPCEngine::load(const uint8* data, unsigned size) {
+  if(size < 0x10200 || memcmp(data, "SNES-SPC700 Sound File Data", 27)) return false;
+
+  regs.pc = data[0x25] | data[0x26] << 8;
+  regs.a = data[0x27];
+  regs.x = data[0x28];
+  regs.y = data[0x29];
+  regs.p = data[0x2a];
+  regs.s = data[0x2b];
+
+  memcpy(apuram, data + 0x100, 64 * 1024);
+  memset(apuram + 64 * 1024, 0, sizeof(apuram) - 64 * 1024);
+
+  //$f0-$ff hold the last values written to the I/O registers
+  status.iplrom_enable = apuram[0xf1] & 0x80;
+  status.dsp_addr = apuram[0xf2];
+  status.ram00f8 = apuram[0xf8];
+  status.ram00f9 = apuram[0xf9];
+  for(unsigned n = 0; n < 4; n++) status.ports[n] = apuram[0xf4 + n];
+
+  //while the IPL ROM is mapped, the RAM beneath it is stored separately
+  if(status.iplrom_enable) memcpy(apuram + 0xffc0, data + 0x101c0, 64);
+
+  for(unsigned n = 0; n < 3; n++) {
+    auto& timer = timers[n];
+    timer.period = n < 2 ? 128 : 16;
+    timer.next = timer.period;
+    timer.enable = apuram[0xf1] & (1 << n);
+    timer.target = apuram[0xfa + n];
+    timer.divider = 0;
+    timer.counter = apuram[0xfd + n];
+  }
+
+  dsp.load(data + 0x10100);
+  cycle = 0;
+  dsp_cycle = 0;
+  sampleoffset = 0;
+  samplecount = 0;
+  return true;
+}
+
+void SPCEngine::render(int16* output, unsigned frames) {
+  while(frames) {
+    if(sampleoffset == samplecount) run();
+    unsigned length = min(frames, (samplecount - sampleoffset) / 2);
+    memcpy(output, samplebuffer + sampleoffset, length * 2 * sizeof(int16));
+    output += length * 2;
+    sampleoffset += length * 2;
+    frames -= length;
+  }
+}
+
+//emulates 512 samples' worth of S-SMP cycles; the S-DSP is then caught up,
+//producing those samples (and possibly one more, for the last instruction's overshoot)
+void SPCEngine::run() {
+  dsp.set_output(samplebuffer, 8192);
+  uint64 target = dsp_cycle + 512 * 32;
+  while(cycle < target) op_step();
+  synchronize_dsp();
+
+  sampleoffset = 0;
+  samplecount = dsp.sample_count();
+}
+
+//the S-DSP is run lazily: only when the S-SMP could observe or affect it
+void SPCEngine::synchronize_dsp() {
+  if(cycle == dsp_cycle) return;
+  dsp.run(cycle - dsp_cycle);
+  dsp_cycle = cycle;
+}
+
+void SPCEngine::Timer::synchronize(uint64 cycle) {
+  if(cycle < next) return;
+  uint64 steps = (cycle - next) / period + 1;
+  next += steps * period;
+  if(enable == false) return;
+
+  unsigned distance = (uint8)(target - divider - 1) + 1;  //steps until divider == target
+  if(steps < distance) {
+    divider += steps;
+    return;
+  }
+
+  unsigned length = target ? (unsigned)target : 256;
+  steps -= distance;
+  counter += (1 + steps / length) & 15;
+  divider = steps % length;
+}
+
+void SPCEngine::op_io() {
+  cycle++;
+}
+
+uint8 SPCEngine::op_read(uint16 addr) {
+  cycle++;
+  return op_busread(addr);
+}
+
+void SPCEngine::op_write(uint16 addr, uint8 data) {
+  cycle++;
+  op_buswrite(addr, data);
+}
+
+uint8 SPCEngine::disassembler_read(uint16 addr) {
+  if((addr & 0xfff0) == 0x00f0) return 0x00;
+  if(addr >= 0xffc0 && status.iplrom_enable) return iplrom[addr & 0x3f];
+  return apuram[addr];
+}
+
+uint8 SPCEngine::op_busread(uint16 addr) {
+  switch(addr) {
+  case 0xf0:  //TEST
+  case 0xf1:  //CONTROL
+  case 0xfa:  //T0TARGET
+  case 0xfb:  //T1TARGET
+  case 0xfc:  //T2TARGET -- write-only registers
+    return 0x00;
+
+  case 0xf2:  //DSPADDR
+    return status.dsp_addr;
+
+  case 0xf3:  //DSPDATA
+    synchronize_dsp();
+    return dsp.read(status.dsp_addr & 0x7f);
+
+  case 0xf4:  //CPUIO0
+  case 0xf5:  //CPUIO1
+  case 0xf6:  //CPUIO2
+  case 0xf7:  //CPUIO3
+    return status.ports[addr & 3];
+
+  case 0xf8:  //RAM0
+    return status.ram00f8;
+
+  case 0xf9:  //RAM1
+    return status.ram00f9;
+
+  case 0xfd:  //T0OUT
+  case 0xfe:  //T1OUT
+  case 0xff: {  //T2OUT -- 4-bit counter value
+    auto& timer = timers[addr - 0xfd];
+    timer.synchronize(cycle);
+    uint8 result = timer.counter;
+    timer.counter = 0;
+    return result;
+  }
+  }
+
+  if(addr >= 0xffc0 && status.iplrom_enable) return iplrom[addr & 0x3f];
+  if(dsp.echo_may_write(addr)) synchronize_dsp();
+  return apuram[addr];
+}
+
+void SPCEngine::op_buswrite(uint16 addr, uint8 data) {
+  //the S-DSP may read any address, as BRR data or echo buffer
+  synchronize_dsp();
+
+  switch(addr) {
+  case 0xf0:  //TEST -- clock speed control is not emulated
+    break;
+
+  case 0xf1:  //CONTROL
+    status.iplrom_enable = data & 0x80;
+    if(data & 0x10) status.ports[0] = status.ports[1] = 0x00;
+    if(data & 0x20) status.ports[2] = status.ports[3] = 0x00;
+
+    //0->1 transition resets timers
+    for(unsigned n = 0; n < 3; n++) {
+      auto& timer = timers[n];
+      timer.synchronize(cycle);
+      bool enable = data & (1 << n);
+      if(timer.enable == false && enable) {
+        timer.divider = 0;
+        timer.counter = 0;
+      }
+      timer.enable = enable;
+    }
+    break;
+
+  case 0xf2:  //DSPADDR
+    status.dsp_addr = data;
+    break;
+
+  case 0xf3:  //DSPDATA
+    if(status.dsp_addr & 0x80) break;  //0x80-0xff are read-only mirrors of 0x00-0x7f
+    dsp.write(status.dsp_addr & 0x7f, data);
+    break;
+
+  case 0xf8:  //RAM0
+    status.ram00f8 = data;
+    break;
+
+  case 0xf9:  //RAM1
+    status.ram00f9 = data;
+    break;
+
+  case 0xfa:  //T0TARGET
+  case 0xfb:  //T1TARGET
+  case 0xfc:  //T2TARGET
+    timers[addr - 0xfa].synchronize(cycle);
+    timers[addr - 0xfa].target = data;
+    break;
+  }
+
+  apuram[addr] = data;  //all writes, even to MMIO registers, appear on bus
+}
@@ -0,0 +1,64 @@
+#ifndef SPC_ENGINE_HPP
+#define SPC_ENGINE_HPP
+
+//APU-only runtime: an S-SMP and S-DSP pair with no S-CPU, PPU or scheduler, for rendering .spc snapshots.
+//all state lives in the instance (the core's smp/dsp singletons are not used),
+//so independent instances may render in parallel threads.
+
+#include <processor/spc700/spc700.hpp>
+#include "../sfc/alt/dsp/SPC_DSP.h"
+
+struct SPCEngine : Processor::SPC700 {
+  enum : unsigned { Frequency = 32000 };  //output rate: one stereo sample per 32 S-SMP cycles
+
+  bool load(const uint8* data, unsigned size);
+  void render(int16* output, unsigned frames);  //interleaved stereo
+
+  SPCEngine();
+
+private:
+  void op_io();
+  uint8 op_read(uint16 addr);
+  void op_write(uint16 addr, uint8 data);
+  uint8 disassembler_read(uint16 addr);
+
+  uint8 op_busread(uint16 addr);
+  void op_buswrite(uint16 addr, uint8 data);
+
+  void run();
+  void synchronize_dsp();
+  void synchronize_timers();
+
+  //timers count 8khz (timer0, timer1) or 64khz (timer2) steps, caught up on access
+  struct Timer {
+    unsigned period;  //cycles per step
+    uint64 next;      //cycle of the next step
+    bool enable;
+    uint8 target;
+    uint8 divider;
+    uint4 counter;
+
+    void synchronize(uint64 cycle);
+  } timers[3];
+
+  struct Status {
+    bool iplrom_enable;
+    uint8 dsp_addr;
+    uint8 ram00f8;
+    uint8 ram00f9;
+    uint8 ports[4];  //values last written by the S-CPU
+  } status;
+
+  uint64 cycle;      //S-SMP cycles executed
+  uint64 dsp_cycle;  //S-DSP clocks executed; always <= cycle
+
+  SPC_DSP dsp;
+  int16 samplebuffer[8192];
+  unsigned sampleoffset;
+  unsigned samplecount;
+
+  //SPC_DSP may read up to 0x300 bytes past the end of RAM when fetching directory entries
+  uint8 apuram[64 * 1024 + 0x300];
+};
+
+#endif
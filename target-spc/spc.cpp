@@ -0,0 +1,80 @@
+//renders .spc snapshots to .wav files with the APU-only engine, as fast as possible.
+//each track gets its own SPCEngine, so tracks are rendered in parallel across --threads.
+
+#include <processor/processor.hpp>
+#include "engine.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+using namespace nall;
+
+static bool render(const string& filename, unsigned seconds) {
+  auto memory = file::read(filename);
+  std::unique_ptr<SPCEngine> engine(new SPCEngine);
+  if(engine->load(memory.data(), memory.size()) == false) {
+    fprintf(stderr, "%s: not an .spc file\n", (const char*)filename);
+    return false;
+  }
+
+  unsigned frames = seconds * SPCEngine::Frequency;
+  std::vector<int16> samples(frames * 2);
+  engine->render(samples.data(), frames);
+
+  string outputname = {nall::basename(filename), ".wav"};
+  file fp;
+  if(fp.open(outputname, file::mode::write) == false) {
+    fprintf(stderr, "%s: cannot write\n", (const char*)outputname);
+    return false;
+  }
+  unsigned length = frames * 2 * sizeof(int16);
+  fp.print("RIFF");
+  fp.writel(36 + length, 4);
+  fp.print("WAVEfmt ");
+  fp.writel(16, 4);
+  fp.writel(1, 2);  //PCM
+  fp.writel(2, 2);  //channels
+  fp.writel(SPCEngine::Frequency, 4);
+  fp.writel(SPCEngine::Frequency * 4, 4);
+  fp.writel(4, 2);  //block alignment
+  fp.writel(16, 2);  //bits per sample
+  fp.print("data");
+  fp.writel(length, 4);
+  for(auto sample : samples) fp.writel((uint16)sample, 2);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned seconds = 180;
+  unsigned threads = std::thread::hardware_concurrency();
+  lstring filenames;
+
+  for(unsigned n = 1; n < argc; n++) {
+    string argument = argv[n];
+    if(argument == "--seconds" && n + 1 < argc) seconds = decimal(argv[++n]);
+    else if(argument == "--threads" && n + 1 < argc) threads = decimal(argv[++n]);
+    else filenames.append(argument);
+  }
+
+  if(filenames.size() == 0 || seconds == 0) {
+    fprintf(stderr, "usage: %s [--seconds N] [--threads N] track.spc ...\n", argv[0]);
+    fprintf(stderr, "  --seconds N  length to render per track (default 180)\n");
+    fprintf(stderr, "  --threads N  tracks to render at once (default: one per core)\n");
+    fprintf(stderr, "writes track.wav next to each track.spc\n");
+    return 1;
+  }
+
+  std::atomic<unsigned> next(0);
+  std::atomic<bool> result(true);
+  auto worker = [&] {
+    for(unsigned n; (n = next++) < filenames.size();) {
+      if(render(filenames[n], seconds) == false) result = false;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for(unsigned n = 1; n < max(1u, min(threads, filenames.size())); n++) pool.emplace_back(worker);
+  worker();
+  for(auto& thread : pool) thread.join();
+  return result ? 0 : 1;
+}